@@ -0,0 +1,33 @@
+/**
+ * eller.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <iostream>
+#include <string>
+
+#include <graphmaze/EllerMazeGenerator.h>
+
+using namespace spelunker::graphmaze;
+
+constexpr auto W = 50;
+constexpr auto H = 1000;
+
+/**
+ * Stream a tall maze to the output a row at a time, without ever holding more than a row in memory.
+ */
+int main() {
+    std::cout << '+' << std::string(2 * W - 1, '-') << "+\n";
+    EllerMazeGenerator{W}.generate(H, [](const EllerMazeGenerator::Row &row) {
+        std::string cells{"|"};
+        std::string floor{"+"};
+        for (auto x = 0; x < W; ++x) {
+            cells += ' ';
+            cells += row.east[x] ? ' ' : '|';
+            floor += row.south[x] ? ' ' : '-';
+            floor += '+';
+        }
+        std::cout << cells << '\n' << floor << '\n';
+    });
+}
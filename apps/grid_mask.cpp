@@ -14,8 +14,12 @@
 #include <graphmaze/BFSMazeGenerator.h>
 #include <graphmaze/BinaryTreeMazeGenerator.h>
 #include <graphmaze/DFSMazeGenerator.h>
+#include <graphmaze/GrowingTreeMazeGenerator.h>
 #include <graphmaze/HuntAndKillMazeGenerator.h>
+#include <graphmaze/KruskalMazeGenerator.h>
 #include <graphmaze/SidewinderMazeGenerator.h>
+#include <graphmaze/WeightedPrimMazeGenerator.h>
+#include <graphmaze/WilsonMazeGenerator.h>
 #include <graphmaze/StringGridMazeRenderer.h>
 
 using namespace spelunker::graphmaze;
@@ -32,7 +36,11 @@ int main() {
     //const auto maze = BFSMazeGenerator{}.generate(graph);
     //const auto maze = BinaryTreeMazeGenerator{}.generate(graph);
     //const auto maze = DFSMazeGenerator{}.generate(graph);
+    //const auto maze = GrowingTreeMazeGenerator<NewestOrRandomPolicy>{}.generate(graph);
     //const auto maze = HuntAndKillMazeGenerator{}.generate(graph);
+    //const auto maze = KruskalMazeGenerator{}.generate(graph);
+    //const auto maze = WeightedPrimMazeGenerator{}.generate(graph);
+    //const auto maze = WilsonMazeGenerator{}.generate(graph);
      const auto [maze, start] = SidewinderMazeGenerator{}.generate(graph);
 
     StringGridMazeRenderer r{std::cout};
@@ -6,20 +6,87 @@
 
 #pragma once
 
+#include <cstddef>
 #include <tuple>
 
+#include <math/DrawBuffer.h>
+#include <math/URBGUtils.h>
+
+#include "GraphUtils.h"
 #include "MazeGenerator.h"
 #include "MazeGraph.h"
+#include "MazeSeed.h"
 
 namespace spelunker::graphmaze {
 
-    class AldousBroderMazeGenerator final : public MazeGenerator {
+    /**
+     * This is a MazeGenerator that works based on the Aldous-Broder algorithm, which generates every spanning tree of
+     * the template with equal probability by a random walk that carves a passage whenever it enters a vertex for the
+     * first time.
+     *
+     * The walk finds new vertices quickly at first, but spends most of its time in the tail, re-crossing visited
+     * vertices to find the last few unvisited ones. WilsonMazeGenerator generates the same distribution of mazes
+     * with loop-erased random walks that need only hit the tree rather than cover the template, and is much faster
+     * on large templates. Switching from this walk to Wilson's algorithm part of the way through is faster still,
+     * but no longer uniform, so it is not offered.
+     *
+     * As the walk must reach every vertex, the template must be connected.
+     */
+    class AldousBroderMazeGenerator final : public GenericMazeGenerator<AldousBroderMazeGenerator> {
     public:
         AldousBroderMazeGenerator() = default;
         virtual ~AldousBroderMazeGenerator() final = default;
 
-        virtual std::pair<const MazeGraph, const vertex> generate(const MazeGraph &tmplt) const final;
+    private:
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        friend class GenericMazeGenerator<AldousBroderMazeGenerator>;
     };
-}
 
+    template<typename T, typename S, typename R>
+    vertex AldousBroderMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
+
+        // Pick a random vertex to start.
+        const auto start = GraphUtils::randomStartVertex(seed.rng, seed.tmplt);
+        auto v = start;
+        std::size_t visitedCells = 1;
+        seed.unvisited.visit(v);
+
+        auto &nbrs = seed.context.getNeighbourBuffer();
+
+        // A random walk makes a draw per step, so draw the random words in blocks.
+        math::DrawBuffer<R> draws{seed.rng};
 
+        // Continue until we have visited all the cells.
+        while (visitedCells < seed.numVertices) {
+            // Get all the neighbours of the current cell and move to one at random.
+            GraphUtils::neighbours(seed, v, nbrs);
+
+            // Select an unvisited neighbour at random.
+            const auto nxt = draws.element(nbrs);
+
+            if (seed.unvisited.tryVisit(nxt)) {
+                ++visitedCells;
+                GraphUtils::addEdge(v, nxt, seed);
+            }
+            v = nxt;
+        }
+
+        return start;
+    }
+
+    /// The generator over a MazeTemplate is instantiated once, in AldousBroderMazeGenerator.cpp.
+    extern template vertex AldousBroderMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex AldousBroderMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex AldousBroderMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
@@ -6,20 +6,82 @@
 
 #pragma once
 
+#include <cstddef>
 #include <tuple>
 
+#include <math/SmallRandom.h>
+
+#include "GraphUtils.h"
 #include "MazeGenerator.h"
 #include "MazeGraph.h"
+#include "MazeSeed.h"
 
 namespace spelunker::graphmaze {
 
-    class BFSMazeGenerator final : public MazeGenerator{
+    class BFSMazeGenerator final : public GenericMazeGenerator<BFSMazeGenerator> {
     public:
         BFSMazeGenerator() = default;
         virtual ~BFSMazeGenerator() final = default;
 
-        virtual std::pair<const MazeGraph, const vertex> generate(const MazeGraph &tmplt) const final;
+    private:
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        friend class GenericMazeGenerator<BFSMazeGenerator>;
     };
-}
 
+    template<typename T, typename S, typename R>
+    vertex BFSMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
+
+        // The queue is a flat buffer from the context: every vertex is enqueued at most once per incident edge
+        // plus once at the start, so it never needs to wrap.
+        auto &queue = seed.context.getVertexBuffer();
+        std::size_t head = 0;
+        auto &nbrs = seed.context.getNeighbourBuffer();
+
+        // We begin by picking a random vertex, and then adding all of its neighbours to the queue.
+        // Each queue iteration carves out a new wall connecting an unvisited vertex to tha maze.
+        // Thus, we don't want BFS to make any edges for the first vertex picked, and we don't
+        // enqueue it.
+        const auto start = GraphUtils::randomStartVertex(seed.rng, seed.tmplt);
+        seed.unvisited.visit(start);
+
+        GraphUtils::neighbours(seed, start, nbrs);
+        for (const auto nbr: nbrs)
+            queue.emplace_back(nbr);
 
+        while (head < queue.size()) {
+            const auto v = queue[head++];
+
+            if (!seed.unvisited.tryVisit(v))
+                continue;
+
+            // Find all its visited neighbours and carve a passage to one of them.
+            GraphUtils::visitedNeighbours(seed, v, nbrs);
+            const auto visitedNbr = math::SmallRandom::element(seed.rng, nbrs);
+            GraphUtils::addEdge(v, visitedNbr, seed);
+
+            // Enqueue all the unvisited neighbours.
+            GraphUtils::unvisitedNeighbours(seed, v, nbrs);
+            math::SmallRandom::shuffle(seed.rng, nbrs);
+            for (const auto nbr: nbrs)
+                queue.emplace_back(nbr);
+        }
+
+        return start;
+    }
+
+    /// The generator over a MazeTemplate is instantiated once, in BFSMazeGenerator.cpp.
+    extern template vertex BFSMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex BFSMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex BFSMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
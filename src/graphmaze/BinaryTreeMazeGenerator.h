@@ -18,19 +18,83 @@
 
 #include <tuple>
 
+#include <math/DrawBuffer.h>
+#include <types/Direction.h>
+#include <types/Exceptions.h>
+
+#include "GraphUtils.h"
 #include "MazeGenerator.h"
 #include "MazeGraph.h"
+#include "MazeSeed.h"
 
 namespace spelunker::graphmaze {
 
-    class BinaryTreeMazeGenerator final : public MazeGenerator {
+    class BinaryTreeMazeGenerator final : public GenericMazeGenerator<BinaryTreeMazeGenerator> {
     public:
         BinaryTreeMazeGenerator() = default;
         virtual ~BinaryTreeMazeGenerator() final = default;
 
-        virtual std::pair<const MazeGraph, const vertex> generate(const MazeGraph &tmplt) const final;
+    private:
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        friend class GenericMazeGenerator<BinaryTreeMazeGenerator>;
     };
-}
 
+    template<typename T, typename S, typename R>
+    vertex BinaryTreeMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
+        const auto &tmplt = seed.tmplt;
+
+        // Make sure that we have a binary tree function, which is needed to pick carving directions.
+        // The context has already evaluated it for each vertex type.
+        if (!tmplt.graphInfo().binaryTreeCandidates.has_value())
+            throw types::UnsupportedMazeGeneration();
+
+        auto &candidates = seed.context.getEdgeBuffer();
+
+        // We make a draw per vertex, so draw the random words in blocks.
+        math::DrawBuffer<R> draws{seed.rng};
 
+        // Start at vertex 0 and just keep carving, forcing carving into new
+        // cells.
+        for (vertex v = 0; v < tmplt.numVertices(); ++v) {
+            // Get the vertex type.
+            const auto &vi = tmplt.vertexInfo(v);
 
+            // Get a list of directions in which we can carve and filter that to get a list of edges to unvisited
+            // vertices that are candidates.
+            const auto &directions = seed.context.getCandidateDirections(vi.type);
+            candidates.clear();
+
+            // Look up the edges in each allowed direction for this vertex type in the template.
+            for (const auto dir: directions)
+                tmplt.forEachNeighbourInDirection(v, dir, [&](const vertex t, const std::size_t e) {
+                    // If we have already visited the target vertex, ignore.
+                    if (seed.unvisited.isUnvisited(t))
+                        candidates.emplace_back(e);
+                });
+
+            // If there are candidates, pick one and carve.
+            if (!candidates.empty()) {
+                GraphUtils::carveEdge(draws.element(candidates), seed);
+                seed.unvisited.visit(v);
+            }
+        }
+
+        return 0;
+    }
+
+    /// The generator over a MazeTemplate is instantiated once, in BinaryTreeMazeGenerator.cpp.
+    extern template vertex BinaryTreeMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex BinaryTreeMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex BinaryTreeMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
@@ -0,0 +1,52 @@
+/**
+ * CarveSink.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+#include <types/Direction.h>
+
+#include "CarveSink.h"
+
+namespace spelunker::graphmaze {
+    LoggingCarveSink::LoggingCarveSink(std::ostream &out)
+        : out{out} {}
+
+    void LoggingCarveSink::onCarve(const CarveEvent &event) {
+        const auto &ei = event.info;
+        out << "Adding edge: " << ei.v1 << ' ' << types::directionShortName(ei.d1) << ' '
+            << ei.v2 << ' ' << types::directionShortName(ei.d2) << '\n';
+    }
+
+    BinaryCarveSink::BinaryCarveSink(std::ostream &out)
+        : out{out} {}
+
+    void BinaryCarveSink::onCarve(const CarveEvent &event) {
+        const std::uint64_t values[] = {event.edge, event.info.v1, event.info.v2};
+        char record[RecordSize];
+        auto pos = 0;
+        for (auto value: values)
+            for (auto i = 0; i < 8; ++i, value >>= 8)
+                record[pos++] = static_cast<char>(value & 0xff);
+        out.write(record, RecordSize);
+    }
+
+    AnimationCarveSink::AnimationCarveSink(FrameCallback frame, const std::size_t stride)
+        : frame{std::move(frame)}, stride{stride} {
+        if (stride == 0)
+            throw std::invalid_argument("AnimationCarveSink requires a positive stride");
+    }
+
+    void AnimationCarveSink::onCarve(const CarveEvent &event) {
+        if (++pending == stride) {
+            pending = 0;
+            frame(event);
+        }
+    }
+}
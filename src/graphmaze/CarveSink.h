@@ -0,0 +1,124 @@
+/**
+ * CarveSink.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Observers of the passages carved by the maze generators.
+ *
+ * A sink is any type offering:
+ * 1. static constexpr bool Enabled, which is false only if the sink ignores all events; and
+ * 2. void onCarve(const CarveEvent &event), called each time a passage is carved.
+ *
+ * The generators are compiled against the sink type, so the default NullCarveSink costs nothing: not even the
+ * event is built. The other sinks derive from CarveObserver, which may also be passed through the virtual interface
+ * of a MazeGenerator.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+
+#include <types/Direction.h>
+
+#include "MazeGraph.h"
+
+namespace spelunker::graphmaze {
+    /// A passage carved during maze generation.
+    struct CarveEvent {
+        /// The index of the edge in the template.
+        std::size_t edge;
+
+        /// The endpoints of the edge, and the direction in which they are connected.
+        EdgeInfo info;
+    };
+
+    /// The sink that ignores all carve events, and against which generation compiles to nothing extra.
+    struct NullCarveSink final {
+        static constexpr bool Enabled = false;
+        inline void onCarve(const CarveEvent&) const noexcept {}
+    };
+
+    /// The abstract sink, to observe carve events at runtime.
+    class CarveObserver {
+    public:
+        static constexpr bool Enabled = true;
+
+        CarveObserver() = default;
+        virtual ~CarveObserver() = default;
+
+        virtual void onCarve(const CarveEvent &event) = 0;
+    };
+
+    /// A sink that logs a line of text for every carve event.
+    class LoggingCarveSink final : public CarveObserver {
+    public:
+        explicit LoggingCarveSink(std::ostream &out);
+        ~LoggingCarveSink() final = default;
+
+        void onCarve(const CarveEvent &event) final;
+
+    private:
+        std::ostream &out;
+    };
+
+    /// A sink that counts the carve events.
+    class CountingCarveSink final : public CarveObserver {
+    public:
+        CountingCarveSink() = default;
+        ~CountingCarveSink() final = default;
+
+        inline void onCarve(const CarveEvent&) noexcept final { ++count; }
+
+        inline std::size_t getCount() const noexcept { return count; }
+        inline void reset() noexcept { count = 0; }
+
+    private:
+        std::size_t count = 0;
+    };
+
+    /**
+     * A sink that captures the carve events to a binary stream.
+     * Each event is written as three little-endian 64-bit unsigned integers: the edge index, and then the two
+     * endpoints of the edge. The stream should be opened in binary mode.
+     */
+    class BinaryCarveSink final : public CarveObserver {
+    public:
+        explicit BinaryCarveSink(std::ostream &out);
+        ~BinaryCarveSink() final = default;
+
+        void onCarve(const CarveEvent &event) final;
+
+        /// The size of a record in bytes.
+        static constexpr std::size_t RecordSize = 24;
+
+    private:
+        std::ostream &out;
+    };
+
+    /**
+     * A sink to animate maze generation, which passes every stride-th carve event to a frame callback.
+     * The events in between are skipped, so that large mazes can be animated at a reasonable number of frames.
+     */
+    class AnimationCarveSink final : public CarveObserver {
+    public:
+        using FrameCallback = std::function<void(const CarveEvent&)>;
+
+        /**
+         * Create an animation sink.
+         * @param frame the callback, invoked for every stride-th carve event
+         * @param stride the number of carve events per frame
+         * @throws std::invalid_argument if stride is 0
+         */
+        explicit AnimationCarveSink(FrameCallback frame, std::size_t stride = 1);
+        ~AnimationCarveSink() final = default;
+
+        void onCarve(const CarveEvent &event) final;
+
+    private:
+        FrameCallback frame;
+        std::size_t stride;
+        std::size_t pending = 0;
+    };
+}
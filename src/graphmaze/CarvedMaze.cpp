@@ -0,0 +1,12 @@
+/**
+ * CarvedMaze.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include "CarvedMaze.h"
+#include "MazeTemplate.h"
+
+namespace spelunker::graphmaze {
+    template class BasicCarvedMaze<MazeTemplate>;
+}
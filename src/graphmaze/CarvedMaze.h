@@ -0,0 +1,160 @@
+/**
+ * CarvedMaze.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/filtered_graph.hpp>
+
+#include <math/BitUtils.h>
+#include <types/Direction.h>
+
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+#include "MazeTemplateGraph.h"
+
+namespace spelunker::graphmaze {
+    template<typename T> class BasicCarvedMaze;
+
+    /// A maze carved out of a frozen MazeTemplate.
+    using CarvedMaze = BasicCarvedMaze<MazeTemplate>;
+
+    /// A BGL edge predicate that keeps only the carved edges of a CarvedMaze.
+    struct CarvedEdgePredicate {
+        const CarvedMaze *maze = nullptr;
+        bool operator()(const TemplateEdge &e) const noexcept;
+    };
+
+    /// A read-only BGL view of the passages of a CarvedMaze.
+    using CarvedMazeView = boost::filtered_graph<MazeTemplate, CarvedEdgePredicate>;
+
+    /// A maze carved out of a template.
+    /**
+     * A maze generated from a template is a subgraph of the template with the same vertices, so rather than
+     * building a second graph, we refer to the (shared, immutable) template and record one bit per template edge,
+     * which is set if the edge has been carved into a passage. Carving is then a single store.
+     *
+     * The template type T may be a MazeTemplate or any type offering the same interface to generators, such as an
+     * ImplicitGridTemplate. The template must outlive the maze. For consumers that expect a graph, toGraph() builds a
+     * standalone MazeGraph, and for a MazeTemplate, view() adapts the maze to the BGL.
+     */
+    template<typename T>
+    class BasicCarvedMaze final {
+    public:
+        /// Create a maze over a template with no passages carved.
+        explicit BasicCarvedMaze(const T &tmplt) { reset(tmplt); }
+
+        BasicCarvedMaze(const BasicCarvedMaze&) = default;
+        BasicCarvedMaze(BasicCarvedMaze&&) = default;
+        BasicCarvedMaze &operator=(const BasicCarvedMaze&) = default;
+        BasicCarvedMaze &operator=(BasicCarvedMaze&&) = default;
+        ~BasicCarvedMaze() = default;
+
+        /**
+         * Rebind the maze to a template and wall up all of the passages.
+         * This reuses the existing storage where possible.
+         */
+        void reset(const T &tmplt);
+
+        inline const T &getTemplate() const noexcept { return *tmplt; }
+
+        /// The vertex at which generation started.
+        inline vertex getStart() const noexcept { return start; }
+        inline void setStart(const vertex v) noexcept { start = v; }
+
+        /// Carve the edge with the given template index into a passage.
+        inline void carve(const std::size_t e) noexcept {
+            bits[e / math::BitUtils::WordBits] |= std::uint64_t{1} << (e % math::BitUtils::WordBits);
+        }
+
+        /// Determine if the edge with the given template index is a passage.
+        inline bool isCarved(const std::size_t e) const noexcept {
+            return (bits[e / math::BitUtils::WordBits] >> (e % math::BitUtils::WordBits)) & 1;
+        }
+
+        /// The number of passages carved.
+        std::size_t numCarved() const noexcept;
+
+        /// Determine if there is a passage from v in direction d.
+        bool hasPassage(vertex v, types::Direction d) const noexcept;
+
+        /**
+         * Visit every passage from v, in neighbour order.
+         * @tparam F a callable taking (vertex target, std::size_t edgeIndex)
+         * @param v the vertex
+         * @param f the callable
+         */
+        template<typename F>
+        inline void forEachPassage(const vertex v, F &&f) const {
+            tmplt->forEachNeighbour(v, [this, &f](const vertex t, const std::size_t e) {
+                if (isCarved(e))
+                    f(t, e);
+            });
+        }
+
+        /// A BGL view of the passages over the template. This is only available over a MazeTemplate.
+        inline CarvedMazeView view() const {
+            return CarvedMazeView{*tmplt, CarvedEdgePredicate{this}};
+        }
+
+        /// Build a standalone MazeGraph containing the vertices of the template and the passages.
+        MazeGraph toGraph() const;
+
+    private:
+        const T *tmplt;
+        std::vector<std::uint64_t> bits;
+        vertex start = 0;
+    };
+
+    inline bool CarvedEdgePredicate::operator()(const TemplateEdge &e) const noexcept {
+        return maze->isCarved(e.index);
+    }
+
+    template<typename T>
+    void BasicCarvedMaze<T>::reset(const T &t) {
+        tmplt = &t;
+        bits.assign(math::BitUtils::numWords(t.numEdges()), 0);
+        start = 0;
+    }
+
+    template<typename T>
+    std::size_t BasicCarvedMaze<T>::numCarved() const noexcept {
+        std::size_t count = 0;
+        for (const auto word: bits)
+            count += math::BitUtils::popCount(word);
+        return count;
+    }
+
+    template<typename T>
+    bool BasicCarvedMaze<T>::hasPassage(const vertex v, const types::Direction d) const noexcept {
+        bool found = false;
+        tmplt->forEachNeighbourInDirection(v, d, [this, &found](vertex, const std::size_t e) {
+            found = found || isCarved(e);
+        });
+        return found;
+    }
+
+    template<typename T>
+    MazeGraph BasicCarvedMaze<T>::toGraph() const {
+        MazeGraph out;
+        for (vertex v = 0; v < tmplt->numVertices(); ++v)
+            boost::add_vertex(tmplt->vertexInfo(v), out);
+        for (std::size_t e = 0; e < tmplt->numEdges(); ++e)
+            if (isCarved(e)) {
+                const auto &ei = tmplt->edgeInfo(e);
+                boost::add_edge(ei.v1, ei.v2, ei, out);
+            }
+        boost::set_property(out, GraphInfoPropertyTag(), tmplt->graphInfo());
+        return out;
+    }
+
+    /// The maze over a MazeTemplate is instantiated once, in CarvedMaze.cpp.
+    extern template class BasicCarvedMaze<MazeTemplate>;
+}
@@ -0,0 +1,29 @@
+/**
+ * ClaimSet.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <math/BitUtils.h>
+
+#include "ClaimSet.h"
+
+namespace spelunker::graphmaze {
+    using math::BitUtils;
+
+    void ClaimSet::reset(const std::size_t n) {
+        const auto numWords = BitUtils::numWords(n);
+        if (numWords > capacity) {
+            words = std::make_unique<std::atomic<std::uint64_t>[]>(numWords);
+            capacity = numWords;
+        }
+        numVertices = n;
+        for (std::size_t i = 0; i < numWords; ++i)
+            words[i].store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * ClaimSet.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <math/BitUtils.h>
+
+namespace spelunker::graphmaze {
+    /// A word-packed set of vertices that many threads may claim at once.
+    /**
+     * Each vertex is represented by one bit, which is set once the vertex has been claimed, e.g. by the thread that
+     * first reaches it. Claiming is an atomic fetch-or on the word holding the bit, so exactly one of any number of
+     * threads claiming the same vertex succeeds. As only the bit itself is published, and not any data that goes
+     * with it, relaxed ordering suffices.
+     *
+     * The words are not a std::vector, as atomics cannot be moved: they are reallocated only when the number of
+     * vertices exceeds the capacity.
+     */
+    class ClaimSet final {
+    public:
+        ClaimSet() = default;
+
+        /// Unclaim every vertex, resizing to numVertices.
+        void reset(std::size_t numVertices);
+
+        /// The number of vertices in the set.
+        inline std::size_t size() const noexcept { return numVertices; }
+
+        /// Determine if a vertex has been claimed. This is safe to run concurrently.
+        inline bool isClaimed(const std::size_t v) const noexcept {
+            return (words[v / math::BitUtils::WordBits].load(std::memory_order_relaxed)
+                    >> (v % math::BitUtils::WordBits)) & 1;
+        }
+
+        /**
+         * Claim a vertex. This is safe to run concurrently.
+         * @return true if this call claimed the vertex, and false if it had already been claimed
+         */
+        inline bool tryClaim(const std::size_t v) noexcept {
+            const auto mask = std::uint64_t{1} << (v % math::BitUtils::WordBits);
+            return !(words[v / math::BitUtils::WordBits].fetch_or(mask, std::memory_order_relaxed) & mask);
+        }
+
+    private:
+        std::size_t numVertices = 0;
+        std::size_t capacity = 0;
+        std::unique_ptr<std::atomic<std::uint64_t>[]> words;
+    };
+}
@@ -0,0 +1,35 @@
+/**
+ * ConcurrentDisjointSets.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "ConcurrentDisjointSets.h"
+
+namespace spelunker::graphmaze {
+    void ConcurrentDisjointSets::resize(const std::size_t n) {
+        if (n > capacity) {
+            parents = std::make_unique<std::atomic<std::size_t>[]>(n);
+            ranks = std::make_unique<std::uint8_t[]>(n);
+            capacity = n;
+        }
+        numVertices = n;
+    }
+
+    void ConcurrentDisjointSets::resetRange(const std::size_t begin, const std::size_t end) noexcept {
+        for (auto v = begin; v < end; ++v) {
+            parents[v].store(v, std::memory_order_relaxed);
+            ranks[v] = 0;
+        }
+    }
+
+    void ConcurrentDisjointSets::reset(const std::size_t n) {
+        resize(n);
+        resetRange(0, n);
+    }
+}
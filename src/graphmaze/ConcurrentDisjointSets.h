@@ -0,0 +1,86 @@
+/**
+ * ConcurrentDisjointSets.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace spelunker::graphmaze {
+    /// A union-find structure over the vertices of a template whose finds may run on many threads at once.
+    /**
+     * This is DisjointSets with the parents held in atomics, for the generators that filter edges in parallel
+     * between phases of merging. Finds may run concurrently with each other, but not with unite or reset:
+     * path splitting then only ever repoints a vertex to one of its ancestors, so racing finds cannot disturb the
+     * structure, and relaxed loads and stores, which compile to plain moves, suffice.
+     *
+     * The arrays are not std::vectors, as atomics cannot be moved: they are reallocated only when the number of
+     * vertices exceeds the capacity.
+     */
+    class ConcurrentDisjointSets final {
+    public:
+        ConcurrentDisjointSets() = default;
+
+        /**
+         * Resize to numVertices vertices without initialising them: use resetRange on every vertex before use,
+         * e.g. in parallel.
+         */
+        void resize(std::size_t numVertices);
+
+        /// Make each vertex of the range [begin,end) a singleton set.
+        void resetRange(std::size_t begin, std::size_t end) noexcept;
+
+        /// Make every vertex a singleton set again, resizing to numVertices.
+        void reset(std::size_t numVertices);
+
+        /// The number of vertices.
+        inline std::size_t size() const noexcept { return numVertices; }
+
+        /// Find the representative of the set containing v, splitting the path to it. This is safe to run concurrently.
+        inline std::size_t find(std::size_t v) noexcept {
+            auto p = parents[v].load(std::memory_order_relaxed);
+            while (p != v) {
+                const auto gp = parents[p].load(std::memory_order_relaxed);
+                parents[v].store(gp, std::memory_order_relaxed);
+                v = p;
+                p = gp;
+            }
+            return v;
+        }
+
+        /// Determine if two vertices are in the same set. This is safe to run concurrently.
+        inline bool connected(const std::size_t v1, const std::size_t v2) noexcept {
+            return find(v1) == find(v2);
+        }
+
+        /**
+         * Merge the sets containing two vertices. This must not run concurrently with any other operation.
+         * @return true if they were in different sets, and false otherwise
+         */
+        inline bool unite(const std::size_t v1, const std::size_t v2) noexcept {
+            auto r1 = find(v1);
+            auto r2 = find(v2);
+            if (r1 == r2)
+                return false;
+
+            if (ranks[r1] < ranks[r2])
+                std::swap(r1, r2);
+            parents[r2].store(r1, std::memory_order_relaxed);
+            if (ranks[r1] == ranks[r2])
+                ++ranks[r1];
+            return true;
+        }
+
+    private:
+        std::size_t numVertices = 0;
+        std::size_t capacity = 0;
+        std::unique_ptr<std::atomic<std::size_t>[]> parents;
+        std::unique_ptr<std::uint8_t[]> ranks;
+    };
+}
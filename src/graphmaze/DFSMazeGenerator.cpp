@@ -4,44 +4,17 @@
  * By Sebastian Raaphorst, 2018.
  */
 
-#include <stack>
-
-#include <math/RNG.h>
+#include <math/URBGUtils.h>
 
 #include "GraphUtils.h"
 #include "MazeGraph.h"
+#include "MazeTemplate.h"
 #include "MazeGenerator.h"
 #include "DFSMazeGenerator.h"
 
 namespace spelunker::graphmaze {
 
-    std::pair<const MazeGraph, const vertex> DFSMazeGenerator::generate(const MazeGraph &tmplt) const {
-        auto seed = GraphUtils::makeSeed(tmplt);
-
-        std::stack<vertex> stack;
-        const auto start = GraphUtils::randomStartVertex(seed.maze);
-        stack.push(start);
-        while (!stack.empty()) {
-            const auto v = stack.top();
-            seed.unvisited[v] = false;
-
-            // Find the list of unvisited neighbours to start.
-            const auto uNbrs = GraphUtils::unvisitedNeighbours(seed, v);
-            if (uNbrs.empty()) {
-                stack.pop();
-                continue;
-            }
-
-            // Select an unvisited neighbour at random.
-            const auto u = math::RNG::randomElement(uNbrs);
-
-            // Add the wall from start to nxt to the output maze.
-            GraphUtils::addEdge(v, u, seed);
-
-            // Enqueue nxt and loop.
-            stack.push(u);
-        }
-
-        return {seed.maze, start};
-    }
-}
\ No newline at end of file
+    template vertex DFSMazeGenerator::carveOver(MazeSeed &seed) const;
+    template vertex DFSMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    template vertex DFSMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
@@ -8,19 +8,47 @@
 
 #include <tuple>
 
+#include "GraphUtils.h"
+#include "GrowingTreeMazeGenerator.h"
 #include "MazeGenerator.h"
 #include "MazeGraph.h"
+#include "MazeSeed.h"
 
 namespace spelunker::graphmaze {
 
     /**
-     * This is a MazeGenerator that works based on a randomized breadth first search.
+     * This is a MazeGenerator that works based on a randomized depth first search.
      */
-    class DFSMazeGenerator final : public MazeGenerator {
+    class DFSMazeGenerator final : public GenericMazeGenerator<DFSMazeGenerator> {
     public:
         DFSMazeGenerator() = default;
         virtual ~DFSMazeGenerator() final = default;
 
-        virtual std::pair<const MazeGraph, const vertex> generate(const MazeGraph &tmplt) const final;
+    private:
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        friend class GenericMazeGenerator<DFSMazeGenerator>;
     };
+
+    template<typename T, typename S, typename R>
+    vertex DFSMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
+
+        // A depth-first search is a growing tree that always grows from the newest cell.
+        return GrowingTreeMazeGenerator<NewestPolicy>::grow(seed, NewestPolicy{});
+    }
+
+    /// The generator over a MazeTemplate is instantiated once, in DFSMazeGenerator.cpp.
+    extern template vertex DFSMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex DFSMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex DFSMazeGenerator::carveOver(SeededMazeSeed &seed) const;
 }
@@ -0,0 +1,23 @@
+/**
+ * DisjointSets.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+
+#include "DisjointSets.h"
+
+namespace spelunker::graphmaze {
+    DisjointSets::DisjointSets(const std::size_t numVertices) {
+        reset(numVertices);
+    }
+
+    void DisjointSets::reset(const std::size_t numVertices) {
+        parents.resize(numVertices);
+        std::iota(parents.begin(), parents.end(), std::size_t{0});
+        ranks.assign(numVertices, 0);
+    }
+}
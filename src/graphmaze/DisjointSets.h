@@ -0,0 +1,71 @@
+/**
+ * DisjointSets.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace spelunker::graphmaze {
+    /// A union-find structure over the vertices of a template, stored as flat arrays.
+    /**
+     * types/DisjointSetHelper.h supplies the property maps for running boost::disjoint_sets over Element structs,
+     * which is convenient for a MazeGraph but scatters the parent and rank of each vertex across a struct. Here, the
+     * parents are a single array indexed by vertex, with the ranks (which never exceed 64) in a parallel byte array,
+     * so that the finds of a generator stay within a few cache lines per vertex.
+     *
+     * Finds use path halving and unions use union by rank, so any sequence of operations runs in near-linear time.
+     */
+    class DisjointSets final {
+    public:
+        DisjointSets() = default;
+
+        /// Create numVertices singleton sets.
+        explicit DisjointSets(std::size_t numVertices);
+
+        /**
+         * Make every vertex a singleton set again, resizing to numVertices.
+         * This is linear in the number of vertices, and reuses the existing storage where possible.
+         */
+        void reset(std::size_t numVertices);
+
+        /// The number of vertices.
+        inline std::size_t size() const noexcept { return parents.size(); }
+
+        /// Find the representative of the set containing v, halving the path to it.
+        inline std::size_t find(std::size_t v) noexcept {
+            while (parents[v] != v) {
+                parents[v] = parents[parents[v]];
+                v = parents[v];
+            }
+            return v;
+        }
+
+        /**
+         * Merge the sets containing two vertices.
+         * @return true if they were in different sets, and false otherwise
+         */
+        inline bool unite(const std::size_t v1, const std::size_t v2) noexcept {
+            auto r1 = find(v1);
+            auto r2 = find(v2);
+            if (r1 == r2)
+                return false;
+
+            if (ranks[r1] < ranks[r2])
+                std::swap(r1, r2);
+            parents[r2] = r1;
+            if (ranks[r1] == ranks[r2])
+                ++ranks[r1];
+            return true;
+        }
+
+    private:
+        std::vector<std::size_t> parents;
+        std::vector<std::uint8_t> ranks;
+    };
+}
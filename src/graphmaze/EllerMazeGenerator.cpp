@@ -0,0 +1,105 @@
+/**
+ * EllerMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+
+#include <math/RNGEngine.h>
+#include <types/AxialOrientation.h>
+#include <types/Exceptions.h>
+#include <types/Tessellations.h>
+
+#include "EllerMazeGenerator.h"
+
+namespace spelunker::graphmaze {
+    EllerMazeGenerator::EllerMazeGenerator(const int width, const types::AxialOrientation xorientation)
+        : width{static_cast<std::size_t>(width)}, xorientation{xorientation} {
+        if (width <= 0 || (xorientation == types::AxialOrientation::LOOPED && width < 3))
+            throw types::IllegalDimensions{width, 0};
+        if (xorientation == types::AxialOrientation::REVERSE_LOOPED)
+            throw types::UnsupportedMazeGeneration{};
+
+        info.width = this->width;
+        info.type = types::TessellationType::GRID;
+
+        labels.resize(this->width);
+        parents.resize(this->width);
+        pending.resize(this->width);
+        nextLabels.resize(this->width);
+        coins.resize(2 * this->width);
+        row.east.resize(this->width);
+        row.south.resize(this->width);
+        reset();
+    }
+
+    void EllerMazeGenerator::reset() noexcept {
+        // Every cell of the first row is in a set of its own.
+        y = 0;
+        std::iota(labels.begin(), labels.end(), 0);
+        std::iota(parents.begin(), parents.end(), 0);
+    }
+
+    void EllerMazeGenerator::generate(const std::size_t height, const RowSink &sink) {
+        math::RNGEngine rng;
+        generate(height, rng, sink);
+    }
+
+    void EllerMazeGenerator::carveRow(const bool last) noexcept {
+        row.y = y;
+
+        // Join adjacent cells in different sets at random, or always in the last row.
+        const auto looped = xorientation == types::AxialOrientation::LOOPED;
+        for (std::size_t x = 0; x < width; ++x) {
+            row.east[x] = false;
+            if (x + 1 == width && !looped)
+                break;
+
+            const auto l1 = find(labels[x]);
+            const auto l2 = find(labels[(x + 1) % width]);
+            if (l1 != l2 && (last || coins[x])) {
+                parents[l2] = l1;
+                row.east[x] = true;
+            }
+        }
+
+        if (last) {
+            for (std::size_t x = 0; x < width; ++x)
+                row.south[x] = false;
+            reset();
+            return;
+        }
+
+        // Count the cells of each set, so that we know when we reach the last cell of a set.
+        for (std::size_t l = 0; l < width; ++l) {
+            pending[l] = 0;
+            nextLabels[l] = NoLabel;
+        }
+        for (std::size_t x = 0; x < width; ++x)
+            ++pending[find(labels[x])];
+
+        // Carve SOUTH at random, and from the last cell of any set that has not yet done so. The cells of the next
+        // row reached by a passage inherit the new label of its set, and the others begin sets of their own, so that
+        // the labels of the next row are again in [0,width).
+        std::uint32_t nextLabel = 0;
+        for (std::size_t x = 0; x < width; ++x) {
+            const auto l = find(labels[x]);
+            const auto rest = --pending[l];
+            const auto south = coins[width + x] || (rest == 0 && nextLabels[l] == NoLabel);
+            row.south[x] = south;
+            if (south) {
+                if (nextLabels[l] == NoLabel)
+                    nextLabels[l] = nextLabel++;
+                labels[x] = nextLabels[l];
+            } else {
+                labels[x] = nextLabel++;
+            }
+        }
+
+        std::iota(parents.begin(), parents.end(), 0);
+        ++y;
+    }
+}
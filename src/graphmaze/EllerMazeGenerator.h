@@ -0,0 +1,162 @@
+/**
+ * EllerMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A generator for grid and cylinder mazes of unbounded height, which streams the maze a row at a time.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <math/RNGEngine.h>
+#include <math/URBGUtils.h>
+#include <types/AxialOrientation.h>
+
+#include "MazeGraph.h"
+
+namespace spelunker::graphmaze {
+    /// A maze generator based on Eller's algorithm, which works one row at a time in memory linear in the width.
+    /**
+     * The cells of the current row are labelled by the set of cells they are connected to in the rows so far. For
+     * each row, adjacent cells in different sets are joined at random, and then each set carves at least one passage
+     * SOUTH into the next row at random: the cells of the next row reached by these passages inherit the labels, and
+     * the other cells begin new sets. In the last row, all adjacent cells in different sets are joined, which
+     * completes a spanning tree.
+     *
+     * Once a row is finished, its passages are handed to a sink and forgotten, so rather than build a MazeGraph, the
+     * generator keeps only a handful of row-sized arrays, and the maze may be arbitrarily tall: e.g. the rows of a
+     * scrolling level may be requested one at a time with nextRow, as they come into view.
+     *
+     * The rows and their edges are those of GraphUtils::makeGrid (when the rows are DISCONNECTED) and
+     * GraphUtils::makeCylinder (when the rows are LOOPED), and of an ImplicitGridTemplate with the same orientation,
+     * with the columns always DISCONNECTED. The other orientations join cells in different rows, so they cannot be
+     * streamed. Since this works without a template, it is not a MazeGenerator.
+     */
+    class EllerMazeGenerator final {
+    public:
+        /// The passages of a finished row.
+        struct Row {
+            /// The index of the row, counting from 0 at the top.
+            std::size_t y = 0;
+
+            /**
+             * east[x] is true if there is a passage from cell x EAST to cell x+1, or, if the rows are LOOPED, from
+             * the last cell to the first.
+             */
+            std::vector<bool> east;
+
+            /// south[x] is true if there is a passage from cell x SOUTH to cell x of the next row.
+            std::vector<bool> south;
+        };
+
+        /// A callback that receives each finished row, which is only valid for the duration of the call.
+        using RowSink = std::function<void(const Row&)>;
+
+        /**
+         * Create a generator for rows of the given width, positioned at the first row.
+         * @param width the width of the rows
+         * @param xorientation the behaviour of rows, as for an ImplicitGridTemplate
+         * @throws IllegalDimensions if the width is not positive, or the rows are LOOPED and have fewer than 3 cells
+         * @throws UnsupportedMazeGeneration if the rows are REVERSE_LOOPED
+         */
+        explicit EllerMazeGenerator(int width,
+                                    types::AxialOrientation xorientation = types::AxialOrientation::DISCONNECTED);
+
+        /// Discard the rows generated so far, and start again from the first row.
+        void reset() noexcept;
+
+        inline std::size_t getWidth() const noexcept { return width; }
+        inline types::AxialOrientation getXOrientation() const noexcept { return xorientation; }
+
+        /**
+         * The properties of the maze, as for the corresponding template: there is no height, as the maze is not
+         * bounded, and no grid rankers, as they require one.
+         */
+        inline const GraphInfo &graphInfo() const noexcept { return info; }
+
+        /// The index of the next row to be generated.
+        inline std::size_t getNextRow() const noexcept { return y; }
+
+        /**
+         * Generate the next row of the maze.
+         * @tparam R the engine type: any uniform random bit generator, or an RNGEngine
+         * @param rng the engine
+         * @param last true if this is the last row, which closes the maze: the generator then starts again
+         * @return the row, which remains valid until the next call
+         */
+        template<typename R>
+        const Row &nextRow(R &rng, bool last = false);
+
+        /**
+         * Generate a whole maze of the given height from the first row, handing each row to a sink in turn.
+         * @tparam R the engine type
+         * @tparam F a callable taking (const Row&)
+         * @param height the number of rows
+         * @param rng the engine
+         * @param sink the sink
+         */
+        template<typename R, typename F>
+        void generate(std::size_t height, R &rng, F &&sink);
+
+        /// As generate, but drawing from the current RNG.
+        void generate(std::size_t height, const RowSink &sink);
+
+    private:
+        static constexpr std::uint32_t NoLabel = UINT32_MAX;
+
+        std::size_t width;
+        types::AxialOrientation xorientation;
+        GraphInfo info;
+
+        /// The index of the next row.
+        std::size_t y = 0;
+
+        /// The label of the set of each cell of the current row, in [0,width).
+        std::vector<std::uint32_t> labels;
+
+        /// A union-find over the labels of the current row, as joining cells merges their sets.
+        std::vector<std::uint32_t> parents;
+
+        /// Per set of the current row: the number of its cells yet to be considered for a SOUTH passage.
+        std::vector<std::uint32_t> pending;
+
+        /// Per set of the current row: its label in the next row, or NoLabel if it has no SOUTH passage yet.
+        std::vector<std::uint32_t> nextLabels;
+
+        /// The coin flips for the row: width to join cells, and width to carve SOUTH.
+        std::vector<std::uint32_t> coins;
+
+        Row row;
+
+        inline std::uint32_t find(std::uint32_t l) noexcept {
+            while (parents[l] != l) {
+                parents[l] = parents[parents[l]];
+                l = parents[l];
+            }
+            return l;
+        }
+
+        /// Carve the current row from the coin flips, and advance the labels to the next row.
+        void carveRow(bool last) noexcept;
+    };
+
+    template<typename R>
+    const EllerMazeGenerator::Row &EllerMazeGenerator::nextRow(R &rng, const bool last) {
+        math::URBGUtils::fillBelow(rng, 2, coins.data(), coins.size());
+        carveRow(last);
+        return row;
+    }
+
+    template<typename R, typename F>
+    void EllerMazeGenerator::generate(const std::size_t height, R &rng, F &&sink) {
+        reset();
+        for (std::size_t y = 0; y < height; ++y)
+            sink(nextRow(rng, y + 1 == height));
+        reset();
+    }
+}
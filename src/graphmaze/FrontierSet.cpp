@@ -0,0 +1,40 @@
+/**
+ * FrontierSet.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstdint>
+
+#include <math/BitUtils.h>
+
+#include "FrontierSet.h"
+
+namespace spelunker::graphmaze {
+    using math::BitUtils;
+
+    FrontierSet::FrontierSet(const std::size_t numVertices) {
+        reset(numVertices);
+    }
+
+    void FrontierSet::reset(const std::size_t n) {
+        numVertices = n;
+        words.assign(BitUtils::numWords(n), 0);
+    }
+
+    std::size_t FrontierSet::findFirst(const std::size_t from) const noexcept {
+        if (from >= numVertices)
+            return npos;
+
+        auto idx = from / BitUtils::WordBits;
+
+        // Mask off the bits before from in the first word.
+        auto word = words[idx] & (~std::uint64_t{0} << (from % BitUtils::WordBits));
+        while (!word) {
+            if (++idx == words.size())
+                return npos;
+            word = words[idx];
+        }
+        return idx * BitUtils::WordBits + BitUtils::countTrailingZeros(word);
+    }
+}
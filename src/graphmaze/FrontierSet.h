@@ -0,0 +1,66 @@
+/**
+ * FrontierSet.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <math/BitUtils.h>
+
+namespace spelunker::graphmaze {
+    /// A word-packed set of vertices, for the frontier of the visited vertices during maze generation.
+    /**
+     * Each vertex is represented by one bit, which is set while the vertex is in the set. Unlike the VisitedSet,
+     * which starts full and only empties, vertices enter and leave the set freely, e.g. an unvisited vertex enters
+     * when one of its neighbours is visited, and leaves when it is visited itself. Searching for the next vertex in
+     * the set proceeds a word (64 vertices) at a time.
+     */
+    class FrontierSet final {
+    public:
+        /// Returned by searches that find nothing.
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        FrontierSet() = default;
+
+        /// Create an empty set over numVertices vertices.
+        explicit FrontierSet(std::size_t numVertices);
+
+        /**
+         * Empty the set, resizing to numVertices.
+         * This is linear in the number of words, and reuses the existing storage where possible.
+         */
+        void reset(std::size_t numVertices);
+
+        /// The number of vertices over which the set is defined.
+        inline std::size_t size() const noexcept { return numVertices; }
+
+        inline bool contains(const std::size_t v) const noexcept {
+            return (words[v / math::BitUtils::WordBits] >> (v % math::BitUtils::WordBits)) & 1;
+        }
+
+        inline void insert(const std::size_t v) noexcept {
+            words[v / math::BitUtils::WordBits] |= std::uint64_t{1} << (v % math::BitUtils::WordBits);
+        }
+
+        inline void erase(const std::size_t v) noexcept {
+            words[v / math::BitUtils::WordBits] &= ~(std::uint64_t{1} << (v % math::BitUtils::WordBits));
+        }
+
+        /**
+         * Find the first vertex in the set at or after a given vertex.
+         * @param from the vertex at which to begin the search
+         * @return the first vertex v >= from in the set, or npos if there is none
+         */
+        std::size_t findFirst(std::size_t from = 0) const noexcept;
+
+    private:
+        std::size_t numVertices = 0;
+        std::vector<std::uint64_t> words;
+    };
+}
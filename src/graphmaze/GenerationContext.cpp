@@ -0,0 +1,25 @@
+/**
+ * GenerationContext.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <vector>
+
+#include <types/Direction.h>
+
+#include "GenerationContext.h"
+
+namespace spelunker::graphmaze {
+    const std::vector<types::Direction> GenerationContext::noDirections;
+
+    void GenerationContext::reset() {
+        unvisited.reset(numVertices);
+        vertexBuffer.clear();
+        neighbourBuffer.clear();
+        edgeBuffer.clear();
+        keyBuffer.clear();
+        spareKeyBuffer.clear();
+        offsetBuffer.clear();
+    }
+}
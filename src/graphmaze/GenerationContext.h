@@ -0,0 +1,230 @@
+/**
+ * GenerationContext.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <math/SeededEngine.h>
+#include <types/Direction.h>
+#include <types/Exceptions.h>
+
+#include "ClaimSet.h"
+#include "ConcurrentDisjointSets.h"
+#include "DisjointSets.h"
+#include "FrontierSet.h"
+#include "IndexedHeap.h"
+#include "MazeGraph.h"
+#include "VisitedSet.h"
+
+namespace spelunker::graphmaze {
+    /// A reusable workspace for generating many mazes from one template.
+    /**
+     * Generating a maze needs a visited set over the vertices and some working storage: a stack, queue, or
+     * processing list of vertices, and buffers for the neighbours or candidate edges under consideration.
+     * A context binds to a template and sizes all of this once, so that between generations it is merely reset
+     * (which is linear in the number of words of the visited set), and generating repeatedly with the same context
+     * into the same CarvedMaze performs no heap allocation once the buffers have settled.
+     *
+     * A context may be created for any type of template (e.g. a MazeTemplate or an ImplicitGridTemplate) but only
+     * generates over templates with the same number of vertices, and may only be used by one generation at a time.
+     * Before each generation, the context is bound to the template of the maze (see bind), which re-evaluates the
+     * binary tree candidate directions if the template has changed.
+     * For very large templates, such as implicit templates of billions of cells, the vertex and edge buffers are not
+     * reserved in advance, as most generators do not need them to be anywhere near their worst-case size: they grow
+     * as needed on the first generation and keep their capacity after that.
+     *
+     * A context also owns an explicitly seeded random engine, so that threads each generating with their own context
+     * share no mutable state, and so that a maze generated from a seed (see MazeGenerator::generateFromSeed) can be
+     * replayed from that seed.
+     */
+    class GenerationContext final {
+    public:
+        /// The largest number of entries that we reserve in advance for the vertex and edge buffers.
+        static constexpr std::size_t ReserveLimit = std::size_t{1} << 24;
+
+        /// Create a context for the given template, with all scratch storage preallocated and a random seed.
+        template<typename T>
+        explicit GenerationContext(const T &tmplt);
+
+        /// Create a context for the given template, with all scratch storage preallocated and the given seed.
+        template<typename T>
+        GenerationContext(const T &tmplt, std::uint64_t seed);
+
+        GenerationContext(const GenerationContext&) = delete;
+        GenerationContext(GenerationContext&&) = default;
+        GenerationContext &operator=(const GenerationContext&) = delete;
+        GenerationContext &operator=(GenerationContext&&) = default;
+        ~GenerationContext() = default;
+
+        /// Mark all vertices as unvisited and empty the buffers, keeping their capacity.
+        void reset();
+
+        /**
+         * Prepare to generate over a template. If it is not the template to which the context is bound, which is
+         * identified by its address, as a CarvedMaze identifies its template, the candidate directions are evaluated
+         * for it, which allocates.
+         * @param tmplt the template
+         * @throws UnsupportedMazeGeneration if the template does not have the number of vertices of the context
+         */
+        template<typename T>
+        void bind(const T &tmplt);
+
+        /// The number of vertices of the templates over which this context generates.
+        inline std::size_t size() const noexcept { return numVertices; }
+
+        /// The random engine of the context.
+        inline math::SeededEngine &getEngine() noexcept { return engine; }
+
+        /// Restart the random engine of the context from the given seed.
+        inline void reseed(const std::uint64_t seed) noexcept { engine.reseed(seed); }
+
+        /// The seed from which the random engine was last seeded.
+        inline std::uint64_t getSeed() const noexcept { return engine.getSeed(); }
+
+        /// The visited set over the vertices of the template.
+        inline UnvisitedVertices &getUnvisited() noexcept { return unvisited; }
+
+        /**
+         * A buffer of vertices for the main working structure of a generator, e.g. its stack or queue.
+         * It has capacity for every vertex plus both endpoints of every edge, which bounds the number of pushes
+         * made by any of the generators here.
+         */
+        inline VertexCollection &getVertexBuffer() noexcept { return vertexBuffer; }
+
+        /// A buffer for the neighbours of a vertex, with capacity for the maximum degree of the template.
+        inline VertexCollection &getNeighbourBuffer() noexcept { return neighbourBuffer; }
+
+        /// A buffer for candidate edge indices, with capacity for every edge of the template.
+        inline std::vector<std::size_t> &getEdgeBuffer() noexcept { return edgeBuffer; }
+
+        /**
+         * A union-find structure over the vertices, for the generators that merge components.
+         * As few generators need it, it is not sized in advance: a generator resets it to the number of vertices
+         * when it starts, which allocates only on its first generation with this context.
+         */
+        inline DisjointSets &getDisjointSets() noexcept { return disjointSets; }
+
+        /// As getDisjointSets, but for the generators that search the sets on several threads at once.
+        inline ConcurrentDisjointSets &getConcurrentDisjointSets() noexcept { return concurrentDisjointSets; }
+
+        /**
+         * A set for the frontier of the visited vertices, for the generators that track it. Like the disjoint sets,
+         * it is not sized in advance, and a generator resets it when it starts.
+         */
+        inline FrontierSet &getFrontier() noexcept { return frontier; }
+
+        /// As getFrontier, but for the generators that claim vertices on several threads at once.
+        inline ClaimSet &getClaimSet() noexcept { return claimSet; }
+
+        /**
+         * An indexed heap over the vertices, for the generators that order the frontier by key. Like the frontier set,
+         * it is not sized in advance.
+         */
+        inline IndexedHeap &getIndexedHeap() noexcept { return indexedHeap; }
+
+        /**
+         * A buffer for 64-bit keys, e.g. random weights of the edges, for the generators that order the edges by key.
+         * Like the disjoint sets, it is not reserved in advance.
+         */
+        inline std::vector<std::uint64_t> &getKeyBuffer() noexcept { return keyBuffer; }
+
+        /// A second buffer for keys, for the generators that move keys between two buffers, e.g. to partition them.
+        inline std::vector<std::uint64_t> &getSpareKeyBuffer() noexcept { return spareKeyBuffer; }
+
+        /**
+         * A buffer for the counts or offsets of the ranges of a parallel loop, e.g. to place the output of each range.
+         * Like the key buffers, it is not reserved in advance.
+         */
+        inline std::vector<std::size_t> &getOffsetBuffer() noexcept { return offsetBuffer; }
+
+        /**
+         * A buffer of vertices for each range of a parallel loop, for the generators whose ranges collect vertices
+         * separately. A generator resizes it to the number of ranges and clears the buffers that it uses, which keep
+         * their capacity from one generation to the next.
+         */
+        inline std::vector<VertexCollection> &getRangeBuffers() noexcept { return rangeBuffers; }
+
+        /**
+         * The binary tree candidate directions for a vertex type, as given by the binaryTreeCandidates function of
+         * the template, evaluated once per type so that generators need not build a deque per vertex.
+         * @param type the vertex type
+         * @return the candidate directions, or an empty collection if the template has no candidate function
+         */
+        inline const std::vector<types::Direction> &getCandidateDirections(const int type) const noexcept {
+            return static_cast<std::size_t>(type) < candidateDirections.size() ? candidateDirections[type] : noDirections;
+        }
+
+    private:
+        std::size_t numVertices;
+        const void *boundTemplate = nullptr;
+        UnvisitedVertices unvisited;
+        VertexCollection vertexBuffer;
+        VertexCollection neighbourBuffer;
+        std::vector<std::size_t> edgeBuffer;
+        std::vector<std::uint64_t> keyBuffer;
+        std::vector<std::uint64_t> spareKeyBuffer;
+        std::vector<std::size_t> offsetBuffer;
+        std::vector<VertexCollection> rangeBuffers;
+        DisjointSets disjointSets;
+        ConcurrentDisjointSets concurrentDisjointSets;
+        FrontierSet frontier;
+        ClaimSet claimSet;
+        IndexedHeap indexedHeap;
+        std::vector<std::vector<types::Direction>> candidateDirections;
+        math::SeededEngine engine;
+
+        /// Returned for vertex types with no candidate directions.
+        static const std::vector<types::Direction> noDirections;
+
+        /// Evaluate the candidate directions for every vertex type of a template.
+        template<typename T>
+        void evaluateCandidateDirections(const T &tmplt);
+    };
+
+    template<typename T>
+    GenerationContext::GenerationContext(const T &tmplt)
+        : GenerationContext{tmplt, math::SeededEngine::randomSeed()} {}
+
+    template<typename T>
+    GenerationContext::GenerationContext(const T &tmplt, const std::uint64_t seed)
+        : numVertices{tmplt.numVertices()}, unvisited{tmplt.numVertices()}, engine{seed} {
+        const auto vertexEntries = tmplt.numVertices() + 2 * tmplt.numEdges();
+        if (vertexEntries <= ReserveLimit)
+            vertexBuffer.reserve(vertexEntries);
+        if (tmplt.numEdges() <= ReserveLimit)
+            edgeBuffer.reserve(tmplt.numEdges());
+        neighbourBuffer.reserve(tmplt.maxDegree());
+        evaluateCandidateDirections(tmplt);
+        boundTemplate = &tmplt;
+    }
+
+    template<typename T>
+    void GenerationContext::bind(const T &tmplt) {
+        if (tmplt.numVertices() != numVertices)
+            throw types::UnsupportedMazeGeneration();
+        if (&tmplt == boundTemplate)
+            return;
+        neighbourBuffer.reserve(tmplt.maxDegree());
+        evaluateCandidateDirections(tmplt);
+        boundTemplate = &tmplt;
+    }
+
+    template<typename T>
+    void GenerationContext::evaluateCandidateDirections(const T &tmplt) {
+        candidateDirections.clear();
+        const auto &candidateFn = tmplt.graphInfo().binaryTreeCandidates;
+        if (candidateFn.has_value()) {
+            candidateDirections.resize(tmplt.numVertexTypes());
+            for (std::size_t type = 0; type < candidateDirections.size(); ++type) {
+                const auto directions = (*candidateFn)(static_cast<int>(type));
+                candidateDirections[type].assign(directions.cbegin(), directions.cend());
+            }
+        }
+    }
+}
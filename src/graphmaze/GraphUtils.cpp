@@ -18,36 +18,113 @@
 #include <types/AxialOrientation.h>
 #include <types/Exceptions.h>
 
+#include "CarvedMaze.h"
+#include "GenerationContext.h"
 #include "MazeGraph.h"
+#include "MazeSeed.h"
+#include "MazeTemplate.h"
+#include "MazeTemplateBuilder.h"
 #include "GraphUtils.h"
 
 namespace spelunker::graphmaze {
 
     MazeGraph GraphUtils::makeGrid(const int width, const int height) {
-        return makeGrid(width, height, types::AxialOrientation::DISCONNECTED, types::AxialOrientation::DISCONNECTED);
+        return buildGrid(width, height, types::AxialOrientation::DISCONNECTED, types::AxialOrientation::DISCONNECTED).toGraph();
+    }
+
+    MazeTemplate GraphUtils::makeGridTemplate(const int width, const int height) {
+        return buildGrid(width, height, types::AxialOrientation::DISCONNECTED, types::AxialOrientation::DISCONNECTED).toTemplate();
     }
 
     MazeGraph GraphUtils::makeCylinder(const int width, const int height) {
-        return makeGrid(width, height, types::AxialOrientation::LOOPED, types::AxialOrientation::DISCONNECTED);
+        return buildGrid(width, height, types::AxialOrientation::LOOPED, types::AxialOrientation::DISCONNECTED).toGraph();
+    }
+
+    MazeTemplate GraphUtils::makeCylinderTemplate(const int width, const int height) {
+        return buildGrid(width, height, types::AxialOrientation::LOOPED, types::AxialOrientation::DISCONNECTED).toTemplate();
     }
 
     MazeGraph GraphUtils::makeTorus(const int width, const int height) {
-        return makeGrid(width, height, types::AxialOrientation::LOOPED, types::AxialOrientation::LOOPED);
+        return buildGrid(width, height, types::AxialOrientation::LOOPED, types::AxialOrientation::LOOPED).toGraph();
+    }
+
+    MazeTemplate GraphUtils::makeTorusTemplate(const int width, const int height) {
+        return buildGrid(width, height, types::AxialOrientation::LOOPED, types::AxialOrientation::LOOPED).toTemplate();
     }
 
     MazeGraph GraphUtils::makeMobiusStrip(const int width, const int height) {
-        return makeGrid(width, height, types::AxialOrientation::REVERSE_LOOPED, types::AxialOrientation::DISCONNECTED);
+        return buildGrid(width, height, types::AxialOrientation::REVERSE_LOOPED, types::AxialOrientation::DISCONNECTED).toGraph();
+    }
+
+    MazeTemplate GraphUtils::makeMobiusStripTemplate(const int width, const int height) {
+        return buildGrid(width, height, types::AxialOrientation::REVERSE_LOOPED, types::AxialOrientation::DISCONNECTED).toTemplate();
     }
 
     MazeGraph GraphUtils::makeKleinBottle(const int width, const int height) {
-        return makeGrid(width, height, types::AxialOrientation::REVERSE_LOOPED, types::AxialOrientation::LOOPED);
+        return buildGrid(width, height, types::AxialOrientation::REVERSE_LOOPED, types::AxialOrientation::LOOPED).toGraph();
+    }
+
+    MazeTemplate GraphUtils::makeKleinBottleTemplate(const int width, const int height) {
+        return buildGrid(width, height, types::AxialOrientation::REVERSE_LOOPED, types::AxialOrientation::LOOPED).toTemplate();
     }
 
     MazeGraph GraphUtils::makeProjectivePlane(const int width, const int height) {
-        return makeGrid(width, height, types::AxialOrientation::REVERSE_LOOPED, types::AxialOrientation::REVERSE_LOOPED);
+        return buildGrid(width, height, types::AxialOrientation::REVERSE_LOOPED, types::AxialOrientation::REVERSE_LOOPED).toGraph();
+    }
+
+    MazeTemplate GraphUtils::makeProjectivePlaneTemplate(const int width, const int height) {
+        return buildGrid(width, height, types::AxialOrientation::REVERSE_LOOPED, types::AxialOrientation::REVERSE_LOOPED).toTemplate();
     }
 
     MazeGraph GraphUtils::makeGridFromMask(std::istream &str) {
+        return buildGridFromMask(str).toGraph();
+    }
+
+    MazeTemplate GraphUtils::makeGridFromMaskTemplate(std::istream &str) {
+        return buildGridFromMask(str).toTemplate();
+    }
+
+    MazeGraph GraphUtils::makeCircular(const int radius) {
+        return buildCircular(radius).toGraph();
+    }
+
+    MazeTemplate GraphUtils::makeCircularTemplate(const int radius) {
+        return buildCircular(radius).toTemplate();
+    }
+
+    MazeGraph GraphUtils::makeSpherical(const int diameter) {
+        return buildSpherical(diameter).toGraph();
+    }
+
+    MazeTemplate GraphUtils::makeSphericalTemplate(const int diameter) {
+        return buildSpherical(diameter).toTemplate();
+    }
+
+    MazeGraph GraphUtils::makeOctagonalGrid(const int width, const int height) {
+        return buildOctagonalGrid(width, height, types::AxialOrientation::DISCONNECTED, types::AxialOrientation::DISCONNECTED).toGraph();
+    }
+
+    MazeTemplate GraphUtils::makeOctagonalGridTemplate(const int width, const int height) {
+        return buildOctagonalGrid(width, height, types::AxialOrientation::DISCONNECTED, types::AxialOrientation::DISCONNECTED).toTemplate();
+    }
+
+    MazeGraph GraphUtils::makeOctagonalCylinder(const int width, const int height) {
+        return buildOctagonalGrid(width, height, types::AxialOrientation::LOOPED, types::AxialOrientation::DISCONNECTED).toGraph();
+    }
+
+    MazeTemplate GraphUtils::makeOctagonalCylinderTemplate(const int width, const int height) {
+        return buildOctagonalGrid(width, height, types::AxialOrientation::LOOPED, types::AxialOrientation::DISCONNECTED).toTemplate();
+    }
+
+    MazeGraph GraphUtils::makeOctagonalTorus(const int width, const int height) {
+        return buildOctagonalGrid(width, height, types::AxialOrientation::LOOPED, types::AxialOrientation::LOOPED).toGraph();
+    }
+
+    MazeTemplate GraphUtils::makeOctagonalTorusTemplate(const int width, const int height) {
+        return buildOctagonalGrid(width, height, types::AxialOrientation::LOOPED, types::AxialOrientation::LOOPED).toTemplate();
+    }
+
+    MazeTemplateBuilder GraphUtils::buildGridFromMask(std::istream &str) {
         // Create a grid of booleans indicating if cells exist or not.
         std::vector<std::vector<bool>> cells;
 
@@ -69,30 +146,36 @@ namespace spelunker::graphmaze {
                 [](const auto &r, const auto &s) { return r.size() < s.size(); })->size();
         std::for_each(cells.begin(), cells.end(), [maxwidth](auto &r) { r.resize(maxwidth, false); });
 
-        MazeGraph g;
+        MazeTemplateBuilder b;
 
-        GridRankerMap ranker;
+        // The cells of a mask are arbitrary, so we record the vertex of each, and use the vertices of the previous
+        // and current rows to create the WEST and NORTH edges.
+        std::vector<std::pair<std::pair<int, int>, vertex>> entries;
+        std::vector<vertex> prevRow(maxwidth);
+        std::vector<vertex> curRow(maxwidth);
         for (auto y = 0; y < cells.size(); ++y) {
-            const auto row = cells[y];
+            const auto &row = cells[y];
             for (auto x = 0; x < row.size(); ++x) {
                 if (!row[x]) continue;
 
-                const auto v = boost::add_vertex(g);
-                ranker[{x,y}] = v;
+                const auto v = b.addVertex();
+                curRow[x] = v;
+                entries.push_back({{x, y}, v});
 
                 // Create any WEST and NORTH edges.
                 if (x > 0 && row[x-1]) {
-                    const auto vw = ranker[{x-1, y}];
+                    const auto vw = curRow[x-1];
                     EdgeInfo ei{v, types::Direction::WEST, vw, types::Direction::EAST};
-                    boost::add_edge(v, vw, ei, g);
+                    b.addEdge(ei);
                 }
 
                 if (y > 0 && cells[y-1][x]) {
-                    const auto vn = ranker[{x, y-1}];
+                    const auto vn = prevRow[x];
                     EdgeInfo ei{v, types::Direction::NORTH, vn, types::Direction::SOUTH};
-                    boost::add_edge(v, vn, ei, g);
+                    b.addEdge(ei);
                 }
             }
+            std::swap(prevRow, curRow);
         }
 
         GraphInfo gi;
@@ -102,30 +185,30 @@ namespace spelunker::graphmaze {
         gi.binaryTreeCandidates = [](int) {
             return std::deque<types::Direction>{types::Direction::EAST, types::Direction::SOUTH};
         };
-        gi.gridRankerMaps = {ranker};
-        boost::set_property(g, GraphInfoPropertyTag(), gi);
-        return g;
+        gi.gridRankers = {GridRanker::sparse(entries)};
+        b.setGraphInfo(gi);
+        return b;
     }
 
-    MazeGraph GraphUtils::makeCircular(int radius) {
-        MazeGraph g;
+    MazeTemplateBuilder GraphUtils::buildCircular(const int radius) {
+        MazeTemplateBuilder b;
 
         // Calculate the ring sizes and create the binary tree function, which
         // always allows us to carve OUT and CLOCKWISE.
         const auto ringSizes = calculateRingSizes(radius);
 
-        // We still want a map from row x column to vertex number, i.e. a ranking function, but more complex
-        // (ha) than in the case of anything grid-like, so we just use a map.
-        GridRankerMap ranker;
+        // We still want a map from row x column to vertex number, i.e. a ranking function. The rings are laid out
+        // one after another, so this is simple arithmetic over the ring sizes.
+        const auto ranker = GridRanker::rings(ringSizes);
 
         // Add the (0,0) vertex.
-        ranker[{0, 0}] = boost::add_vertex(g);
+        b.addVertex();
 
         for (auto row = 1; row < radius; ++row) {
             // Add the cells for this row.
             const int cols = ringSizes[row];
             for (int col = 0; col < cols; ++col)
-                ranker[{row, col}] = boost::add_vertex(g);
+                b.addVertex();
 
             // Now add the adjacencies.
             // The ratio, which is integral, dictates the number of columns in this row per column of the previous
@@ -133,18 +216,18 @@ namespace spelunker::graphmaze {
             const auto ratio = cols / ringSizes[row - 1];
 
             for (int col = 0; col < cols; ++col) {
-                const vertex v = ranker[{row, col}];
+                const vertex v = ranker.at(row, col);
 
                 // As we are undirected, we only need to connect to our clockwise neighbour.
                 int nextCol = (col + 1) % cols;
-                const vertex vn = ranker[{row, nextCol}];
+                const vertex vn = ranker.at(row, nextCol);
                 const EdgeInfo ein { v, types::Direction::CLOCKWISE, vn, types::Direction::COUNTERCLOCKWISE };
-                boost::add_edge(v, vn, ein, g);
+                b.addEdge(ein);
 
                 // Connect to the parent.
-                const vertex vp = ranker[{row - 1, col / ratio}];
+                const vertex vp = ranker.at(row - 1, col / ratio);
                 const EdgeInfo eip { v, types::Direction::IN, vp, types::Direction::OUT };
-                boost::add_edge(v, vp, eip, g);
+                b.addEdge(eip);
             }
         }
 
@@ -155,9 +238,9 @@ namespace spelunker::graphmaze {
         gi.binaryTreeCandidates = [](int) {
             return std::deque<types::Direction>{types::Direction::CLOCKWISE, types::Direction::OUT};
         };
-        gi.gridRankerMaps = {ranker};
-        boost::set_property(g, GraphInfoPropertyTag(), gi);
-        return g;
+        gi.gridRankers = {ranker};
+        b.setGraphInfo(gi);
+        return b;
     }
 
     /**
@@ -167,48 +250,52 @@ namespace spelunker::graphmaze {
      * 3. We want vertex numbers to be strictly increasing from north pole to south pole.
      * Thus, we recode this to achieve these specifications, despite the repetitiveness.
      */
-    MazeGraph GraphUtils::makeSpherical(int diameter) {
-        MazeGraph g;
+    MazeTemplateBuilder GraphUtils::buildSpherical(const int diameter) {
+        MazeTemplateBuilder b;
 
         // Calculate the ring sizes. If radius is odd, then we want to include the equator in this calculation.
         const auto northernRows = diameter / 2 + diameter % 2;
         const auto ringSizes = calculateRingSizes(northernRows);
 
-        // We still want a map from row x column to vertex number, i.e. a ranking function, but more complex
-        // (ha) than in the case of anything grid-like, so we just use a map.
-        GridRankerMap ranker;
+        // We still want a map from row x column to vertex number, i.e. a ranking function. The rows of latitude are
+        // laid out one after another from the north pole to the south pole, so this is simple arithmetic over the
+        // sizes of the rows, which are the ring sizes of the northern hemisphere followed by those of the southern.
+        std::vector<int> rowSizes{ringSizes.cbegin(), ringSizes.cend()};
+        for (int southRow = ringSizes.size() - 1 - diameter % 2; southRow >= 0; --southRow)
+            rowSizes.emplace_back(ringSizes[southRow]);
+        const auto ranker = GridRanker::rings(rowSizes);
 
         // Create the two halves of the sphere separately.
         // This will give us a nicer ordering on the vertices: they will continuously increase from
         // north pole to south pole.
 
         // Begin by adding the north pole.
-        ranker[{0, 0}] = boost::add_vertex(g);
+        b.addVertex();
 
         // Now create the northern hemisphere, and if radius is odd, the equator.
         for (auto row = 1; row < northernRows; ++row) {
             // Add the cells for this ring of latitude.
             const int cols = ringSizes[row];
             for (int col = 0; col < cols; ++col)
-                ranker[{row, col}] = boost::add_vertex(g);
+                b.addVertex();
 
             // Now add the adjacencies.
             // The ratio, as in the case of the circular maze, indicates the northern parent.
             const auto ratio = cols / ringSizes[row - 1];
 
             for (int col = 0; col < cols; ++col) {
-                const vertex v = ranker[{row, col}];
+                const vertex v = ranker.at(row, col);
 
                 // Link east.
                 int nextCol = (col + 1) % cols;
-                const vertex ve = ranker[{row, nextCol}];
+                const vertex ve = ranker.at(row, nextCol);
                 const EdgeInfo eie { v, types::Direction::EAST, ve, types::Direction::WEST };
-                boost::add_edge(v, ve, eie, g);
+                b.addEdge(eie);
 
                 // Link north.
-                const vertex vn = ranker[{row - 1, col / ratio}];
+                const vertex vn = ranker.at(row - 1, col / ratio);
                 const EdgeInfo ein { v, types::Direction::NORTH, vn, types::Direction::SOUTH };
-                boost::add_edge(v, vn, ein, g);
+                b.addEdge(ein);
             }
         }
 
@@ -219,7 +306,7 @@ namespace spelunker::graphmaze {
             // Add the cells for this ring of latitude.
             const int cols = ringSizes[southRow];
             for (int col = 0; col < cols; ++col)
-                ranker[{curRow, col}] = boost::add_vertex(g);
+                b.addVertex();
 
             // Now add the adjacencies.
             // The ratio will dictate how many cells in the north latitude correspond to each in this one.
@@ -228,21 +315,21 @@ namespace spelunker::graphmaze {
 
             int prevCt = 0;
             for (int col = 0; col < cols; ++col) {
-                const vertex v = ranker[{curRow, col}];
+                const vertex v = ranker.at(curRow, col);
 
                 // Link east if we aren't at the south pole.
                 if (southRow > 0) {
                     int nextCol = (col + 1) % cols;
-                    const vertex ve = ranker[{curRow, nextCol}];
+                    const vertex ve = ranker.at(curRow, nextCol);
                     const EdgeInfo eie{v, types::Direction::EAST, ve, types::Direction::WEST};
-                    boost::add_edge(v, ve, eie, g);
+                    b.addEdge(eie);
                 }
 
                 // Link north.
                 for (int i = 0; i < ratio; ++i) {
-                    const vertex vn = ranker[{curRow - 1, prevCt}];
+                    const vertex vn = ranker.at(curRow - 1, prevCt);
                     const EdgeInfo ein { v, types::Direction::NORTH, vn, types::Direction::SOUTH };
-                    boost::add_edge(v, vn, ein, g);
+                    b.addEdge(ein);
                     ++prevCt;
                 }
             }
@@ -260,61 +347,15 @@ namespace spelunker::graphmaze {
         gi.binaryTreeCandidates = [](int) {
             return std::deque<types::Direction>{types::Direction::EAST, types::Direction::SOUTH};
         };
-        gi.gridRankerMaps = {ranker};
-        boost::set_property(g, GraphInfoPropertyTag(), gi);
-        return g;
-    }
-
-    MazeGraph GraphUtils::makeOctagonalGrid(int width, int height) {
-        return makeOctagonalGrid(width, height, types::AxialOrientation::DISCONNECTED, types::AxialOrientation::DISCONNECTED);
-    }
-
-    MazeGraph GraphUtils::makeOctagonalCylinder(int width, int height) {
-        return makeOctagonalGrid(width, height, types::AxialOrientation::LOOPED, types::AxialOrientation::DISCONNECTED);
-    }
-
-    MazeGraph GraphUtils::makeOctagonalTorus(int width, int height) {
-        return makeOctagonalGrid(width, height, types::AxialOrientation::LOOPED, types::AxialOrientation::LOOPED);
-    }
-
-    MazeSeed GraphUtils::makeSeed(const MazeGraph &tmplt) noexcept {
-        return MazeSeed {
-            tmplt,
-            createInitialMaze(tmplt),
-            numVertices(tmplt),
-            initializeUnvisitedVertices(tmplt)
-        };
+        gi.gridRankers = {ranker};
+        b.setGraphInfo(gi);
+        return b;
     }
 
     vertex GraphUtils::randomStartVertex(const MazeGraph &maze) noexcept {
         return math::DefaultRNG::randomRange(numVertices(maze));
     }
 
-    VertexCollection GraphUtils::unvisitedNeighbours(const MazeSeed &seed, const vertex &v) {
-        return nbrs(seed, v, false);
-    }
-
-    VertexCollection GraphUtils::visitedNeighbours(const MazeSeed &seed, const vertex &v) {
-        return nbrs(seed, v, true);
-    }
-
-    VertexCollection GraphUtils::neighbours(const MazeSeed &seed, const vertex &v) {
-        VertexCollection neighbours;
-        for (auto [eIter, eEnd] = boost::out_edges(v, seed.tmplt); eIter != eEnd; ++eIter) {
-            const auto t = boost::target(*eIter, seed.tmplt);
-            neighbours.emplace_back(t);
-        }
-        return neighbours;
-    }
-
-    void GraphUtils::addEdge(vertex v1, vertex v2, MazeSeed &seed) {
-        // Get the edge properties from the template.
-        auto edge = boost::edge(v1, v2, seed.tmplt);
-        auto edgeInfo = boost::get(EdgeInfoPropertyTag(), seed.tmplt, edge.first);
-        std::cout << "Adding edge: " << edgeInfo.v1 << " " << types::directionShortName(edgeInfo.d1) << " " << edgeInfo.v2 << " " << types::directionShortName(edgeInfo.d2) << std::endl;
-        boost::add_edge(v1, v2, edgeInfo, seed.maze);
-    }
-
     void GraphUtils::outputGraph(std::ostream &out, const MazeGraph &graph) {
         for (auto [eIter, eEnd] = boost::edges(graph); eIter != eEnd; ++eIter)
             std::cout << "Edge " << *eIter << std::endl;
@@ -329,28 +370,34 @@ namespace spelunker::graphmaze {
         assert(e == v - 1);
     }
 
+    void GraphUtils::outputGraph(std::ostream &out, const CarvedMaze &maze) {
+        const auto &tmplt = maze.getTemplate();
+        for (std::size_t e = 0; e < tmplt.numEdges(); ++e)
+            if (maze.isCarved(e)) {
+                const auto &ei = tmplt.edgeInfo(e);
+                out << "Edge (" << ei.v1 << "," << ei.v2 << ")\n";
+            }
+
+        // These are perfect mazes, so we should have |edges| = #vertices - 1.
+        const auto v = tmplt.numVertices();
+        const auto e = maze.numCarved();
+
+        out << v << " vertices, " << e << " edges\n";
+        assert(e == v - 1);
+    }
+
     const std::optional<BTCandidateFunction> &GraphUtils::getCandidateFunction(const MazeGraph &graph) {
         return boost::get_property(graph, GraphInfoPropertyTag()).binaryTreeCandidates;
     }
 
-    const std::vector<GridRankerMap> &GraphUtils::getRankerFunctions(const MazeGraph &graph) {
-        return boost::get_property(graph, GraphInfoPropertyTag()).gridRankerMaps;
+    const std::vector<GridRanker> &GraphUtils::getRankerFunctions(const MazeGraph &graph) {
+        return boost::get_property(graph, GraphInfoPropertyTag()).gridRankers;
     }
 
     const GraphInfo &GraphUtils::getGraphInfo(const MazeGraph &graph) {
         return boost::get_property(graph, GraphInfoPropertyTag());
     }
 
-    VertexCollection GraphUtils::nbrs(const MazeSeed &seed, const vertex &v, const bool visited) {
-        VertexCollection vc;
-        for (auto [eIter, eEnd] = boost::out_edges(v, seed.tmplt); eIter != eEnd; ++eIter) {
-            const vertex t = boost::target(*eIter, seed.tmplt);
-            if (seed.unvisited.at(t) != visited)
-                vc.emplace_back(t);
-        }
-        return vc;
-    }
-
     std::vector<int> GraphUtils::calculateRingSizes(const int radius) {
         if (radius <= 0)
             throw std::invalid_argument("Radius must be positive.");
@@ -372,32 +419,32 @@ namespace spelunker::graphmaze {
         return sizes;
     }
 
-    MazeGraph GraphUtils::makeGrid(const int width, const int height,
-                                   const types::AxialOrientation xorientation,
-                                   const types::AxialOrientation yorientation) {
-        MazeGraph g;
+    MazeTemplateBuilder GraphUtils::buildGrid(const int width, const int height,
+                                              const types::AxialOrientation xorientation,
+                                              const types::AxialOrientation yorientation) {
+        MazeTemplateBuilder b;
 
-        GridRankerMap ranker;
+        const auto ranker = GridRanker::dense(width, height);
         for (auto y = 0; y < height; ++y)
             for (auto x = 0; x < width; ++x)
-                ranker[{x, y}] = boost::add_vertex(g);
+                b.addVertex();
 
         // Now add all east and south edges.
         for (auto y = 0; y < height; ++y) {
             for (auto x = 0; x < width; ++x) {
                 // Check if we can add east.
                 if (x < width - 1) {
-                    const vertex v1 = ranker[{x, y}];
-                    const vertex v2 = ranker[{x + 1, y}];
+                    const vertex v1 = ranker.at(x, y);
+                    const vertex v2 = ranker.at(x + 1, y);
                     const EdgeInfo ei { v1, types::Direction::EAST, v2, types::Direction::WEST };
-                    boost::add_edge(v1, v2, ei, g);
+                    b.addEdge(ei);
                 }
                 // Check if we can add south.
                 if (y < height - 1) {
-                    const vertex v1 = ranker[{x, y}];
-                    const vertex v2 = ranker[{x, y + 1}];
+                    const vertex v1 = ranker.at(x, y);
+                    const vertex v2 = ranker.at(x, y + 1);
                     const EdgeInfo ei { v1, types::Direction::SOUTH, v2, types::Direction::NORTH };
-                    boost::add_edge(v1, v2, ei, g);
+                    b.addEdge(ei);
                 }
             }
         }
@@ -406,10 +453,10 @@ namespace spelunker::graphmaze {
         if (xorientation != types::AxialOrientation::DISCONNECTED) {
             bool flip = xorientation == types::AxialOrientation::REVERSE_LOOPED;
             for (auto y = 0; y < height; ++y) {
-                const vertex v1 = ranker[{0, y}];
-                const vertex v2 = ranker[{width - 1, flip ? (height - y - 1) : y}];
+                const vertex v1 = ranker.at(0, y);
+                const vertex v2 = ranker.at(width - 1, flip ? (height - y - 1) : y);
                 const EdgeInfo ei { v1, types::Direction::WEST, v2, types::Direction::EAST };
-                boost::add_edge(v1, v2, ei, g);
+                b.addEdge(ei);
             }
         }
 
@@ -417,10 +464,10 @@ namespace spelunker::graphmaze {
         if (yorientation != types::AxialOrientation::DISCONNECTED) {
             bool flip = yorientation == types::AxialOrientation::REVERSE_LOOPED;
             for (auto x = 0; x < width; ++x) {
-                const vertex v1 = ranker[{x, 0}];
-                const vertex v2 = ranker[{flip ? (width - x - 1) : x, height - 1}];
+                const vertex v1 = ranker.at(x, 0);
+                const vertex v2 = ranker.at(flip ? (width - x - 1) : x, height - 1);
                 const EdgeInfo ei { v1, types::Direction::NORTH, v2, types::Direction::SOUTH };
-                boost::add_edge(v1, v2, ei, g);
+                b.addEdge(ei);
             }
         }
 
@@ -431,53 +478,56 @@ namespace spelunker::graphmaze {
         gi.binaryTreeCandidates = [](int) {
             return std::deque<types::Direction>{types::Direction::EAST, types::Direction::SOUTH};
         };
-        gi.gridRankerMaps = {ranker};
-        boost::set_property(g, GraphInfoPropertyTag(), gi);
-        return g;
+        gi.gridRankers = {ranker};
+        b.setGraphInfo(gi);
+        return b;
     }
 
-    MazeGraph GraphUtils::makeOctagonalGrid(int width, int height,
-                                            types::AxialOrientation xorientation, types::AxialOrientation yorientation) {
+    MazeTemplateBuilder GraphUtils::buildOctagonalGrid(const int width, const int height,
+                                                       const types::AxialOrientation xorientation,
+                                                       const types::AxialOrientation yorientation) {
         // We don't support reverse-looping.
         if (xorientation == types::AxialOrientation::REVERSE_LOOPED
             || yorientation == types::AxialOrientation::REVERSE_LOOPED)
             throw types::UnsupportedTemplateGeneration{};
 
-        MazeGraph g;
-        GridRankerMap octagonalRanker;
-        GridRankerMap diamondRanker;
+        MazeTemplateBuilder b;
+        const auto diamondWidth = width - (xorientation == types::AxialOrientation::DISCONNECTED ? 1 : 0);
+        const auto diamondHeight = height - (yorientation == types::AxialOrientation::DISCONNECTED ? 1 : 0);
+
+        // The octagons come first, followed by the diamonds, each in row-major order.
+        const auto octagonalRanker = GridRanker::dense(width, height);
+        const auto diamondRanker = GridRanker::dense(diamondWidth, diamondHeight, octagonalRanker.size());
 
         for (auto y = 0; y < height; ++y)
             for (auto x = 0; x < width; ++x) {
                 VertexInfo vi { 0 };
-                octagonalRanker[{x, y}] = boost::add_vertex(vi, g);
+                b.addVertex(vi);
             }
 
-        const auto diamondWidth = width - (xorientation == types::AxialOrientation::DISCONNECTED ? 1 : 0);
-        const auto diamondHeight = height - (yorientation == types::AxialOrientation::DISCONNECTED ? 1 : 0);
-        for (auto y = 0; y < diamondWidth; ++y)
-            for (auto x = 0; x < diamondHeight; ++x) {
+        for (auto y = 0; y < diamondHeight; ++y)
+            for (auto x = 0; x < diamondWidth; ++x) {
                 VertexInfo vi { 1 };
-                diamondRanker[{x, y}] = boost::add_vertex(vi, g);
+                b.addVertex(vi);
             }
 
         // Add all the octagonal - octagonal edges.
         for (auto y = 0; y < height; ++y)
             for (auto x = 0; x < width; ++x) {
-                const auto v = octagonalRanker[{x, y}];
+                const auto v = octagonalRanker.at(x, y);
 
                 // SOUTH
                 if (y + 1 < height || yorientation == types::AxialOrientation::LOOPED) {
-                    const auto vs = octagonalRanker[{x, y + 1 < height ? y + 1 : 0}];
+                    const auto vs = octagonalRanker.at(x, y + 1 < height ? y + 1 : 0);
                     EdgeInfo ei{v, types::Direction::SOUTH, vs, types::Direction::NORTH};
-                    boost::add_edge(v, vs, ei, g);
+                    b.addEdge(ei);
                 }
 
                 // EAST
                 if (x + 1 < width || xorientation == types::AxialOrientation::LOOPED) {
-                    const auto ve = octagonalRanker[{x + 1 < width ? x + 1 : 0, y}];
+                    const auto ve = octagonalRanker.at(x + 1 < width ? x + 1 : 0, y);
                     EdgeInfo ei{v, types::Direction::EAST, ve, types::Direction::WEST};
-                    boost::add_edge(v, ve, ei, g);
+                    b.addEdge(ei);
                 }
             }
 
@@ -488,40 +538,31 @@ namespace spelunker::graphmaze {
         //    the east and the south if looped.
         for (auto y = 0; y < diamondHeight; ++y)
             for (auto x = 0; x < diamondWidth; ++x) {
-                const auto v = diamondRanker[{x, y}];
+                const auto v = diamondRanker.at(x, y);
 
                 const auto xe = (x + 1 == diamondWidth && xorientation == types::AxialOrientation::LOOPED) ? 0 : x + 1;
                 const auto ys = (y + 1 == diamondHeight && yorientation == types::AxialOrientation::LOOPED) ? 0 : y + 1;
 
                 // NORTHWEST: never need to loop.
-                const auto vnw = octagonalRanker[{x, y}];
+                const auto vnw = octagonalRanker.at(x, y);
                 EdgeInfo einw{ v, types::Direction::NORTHWEST, vnw, types::Direction::SOUTHEAST};
-                boost::add_edge(v, vnw, einw, g);
+                b.addEdge(einw);
 
                 // NORTHEAST: need to loop if on east boundary.
-                const auto vne = octagonalRanker[{xe, y}];
+                const auto vne = octagonalRanker.at(xe, y);
                 EdgeInfo eine{v, types::Direction::NORTHEAST, vne, types::Direction::SOUTHWEST};
-                boost::add_edge(v, vne, eine, g);
+                b.addEdge(eine);
 
                 // SOUTHWEST: need to loop if on south boundary.
-                const auto vsw = octagonalRanker[{x, ys}];
+                const auto vsw = octagonalRanker.at(x, ys);
                 EdgeInfo eisw{v, types::Direction::SOUTHWEST, vsw, types::Direction::NORTHEAST};
-                boost::add_edge(v, vsw, eisw, g);
+                b.addEdge(eisw);
 
                 // SOUTHEAST: need to loop if on south and / or east boundary.
-                const auto vse = octagonalRanker[{xe, ys}];
+                const auto vse = octagonalRanker.at(xe, ys);
                 EdgeInfo eise{v, types::Direction::SOUTHEAST, vse, types::Direction::NORTHWEST};
             }
 
-        // Merge the two rankers.
-        GridRankerMap ranker;
-        for (auto y = 0; y < height; ++y)
-            for (auto x = 0; x < width; ++x)
-                ranker[{x, y}] = octagonalRanker[{x, y}];
-        for (auto y = 0; y < diamondHeight; ++y)
-            for (auto x = 0; x < diamondWidth; ++x)
-                ranker[{x + width, y + height}] = diamondRanker[{x, y}];
-
         GraphInfo gi;
         gi.width = width;
         gi.height = height;
@@ -536,24 +577,9 @@ namespace spelunker::graphmaze {
                     return std::deque<types::Direction>{};
             }
         };
-        gi.gridRankerMaps = {octagonalRanker, diamondRanker};
-        boost::set_property(g, GraphInfoPropertyTag(), gi);
-        return g;
-    }
-
-    MazeGraph GraphUtils::createInitialMaze(const MazeGraph &tmplt) noexcept {
-        MazeGraph out;
-        for (auto[vIter, vEnd] = boost::vertices(tmplt); vIter != vEnd; ++vIter)
-            boost::add_vertex(out);
-        boost::set_property(out, GraphInfoPropertyTag(), boost::get_property(tmplt, GraphInfoPropertyTag()));
-        return out;
-    }
-
-    UnvisitedVertices GraphUtils::initializeUnvisitedVertices(const MazeGraph &tmplt) noexcept {
-        UnvisitedVertices unvisited;
-        for (auto[vIter, vEnd] = boost::vertices(tmplt); vIter != vEnd; ++vIter)
-            unvisited[*vIter] = true;
-        return unvisited;
+        gi.gridRankers = {octagonalRanker, diamondRanker};
+        b.setGraphInfo(gi);
+        return b;
     }
 
     int GraphUtils::numVertices(const MazeGraph &maze) {
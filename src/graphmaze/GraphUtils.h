@@ -11,8 +11,18 @@
 #include <optional>
 #include <tuple>
 
+#include <math/URBGUtils.h>
 #include <types/AxialOrientation.h>
+#include <types/Direction.h>
+#include <types/Exceptions.h>
+
+#include "CarveSink.h"
+#include "CarvedMaze.h"
+#include "GenerationContext.h"
 #include "MazeGraph.h"
+#include "MazeSeed.h"
+#include "MazeTemplate.h"
+#include "MazeTemplateBuilder.h"
 
 namespace spelunker::graphmaze {
 
@@ -29,6 +39,9 @@ namespace spelunker::graphmaze {
          */
         static MazeGraph makeGrid(int width, int height);
 
+        /// As makeGrid, but emits a frozen MazeTemplate.
+        static MazeTemplate makeGridTemplate(int width, int height);
+
         /**
          * Create a maze template representing a cylinder.
          * This links one of the axes (x) regularly, i.e. there are edges between:
@@ -39,6 +52,9 @@ namespace spelunker::graphmaze {
          */
         static MazeGraph makeCylinder(int width, int height);
 
+        /// As makeCylinder, but emits a frozen MazeTemplate.
+        static MazeTemplate makeCylinderTemplate(int width, int height);
+
         /**
          * Create a maze template representing a torus.
          * This links both axes regularly, i.e. there are edges between:
@@ -50,6 +66,9 @@ namespace spelunker::graphmaze {
          */
         static MazeGraph makeTorus(int width, int height);
 
+        /// As makeTorus, but emits a frozen MazeTemplate.
+        static MazeTemplate makeTorusTemplate(int width, int height);
+
         /**
          * Creata a maze template representing a mobius strip.
          * This links one of the axes (x) in reverse, i.e. there are edges between:
@@ -60,6 +79,9 @@ namespace spelunker::graphmaze {
          */
         static MazeGraph makeMobiusStrip(int width, int height);
 
+        /// As makeMobiusStrip, but emits a frozen MazeTemplate.
+        static MazeTemplate makeMobiusStripTemplate(int width, int height);
+
         /**
          * Create a maze template representing a Klein bottle.
          * This links one of the axes (x) in reverse, and one (y) regularly,
@@ -72,6 +94,9 @@ namespace spelunker::graphmaze {
          */
         static MazeGraph makeKleinBottle(int width, int height);
 
+        /// As makeKleinBottle, but emits a frozen MazeTemplate.
+        static MazeTemplate makeKleinBottleTemplate(int width, int height);
+
         /**
          * Create a maze template representing a projective plane.
          * This links the axes in reverse, i.e. there are edges between:
@@ -83,6 +108,9 @@ namespace spelunker::graphmaze {
          */
         static MazeGraph makeProjectivePlane(int width, int height);
 
+        /// As makeProjectivePlane, but emits a frozen MazeTemplate.
+        static MazeTemplate makeProjectivePlaneTemplate(int width, int height);
+
         /**
          * Create a grid from a mask as read by a stream.
          * Cells should be indicated with anything other than a space,
@@ -98,6 +126,9 @@ namespace spelunker::graphmaze {
          */
         static MazeGraph makeGridFromMask(std::istream &str);
 
+        /// As makeGridFromMask, but emits a frozen MazeTemplate.
+        static MazeTemplate makeGridFromMaskTemplate(std::istream &str);
+
         /**
          * Create a circular maze of radius rings, and uses adaptive subdivision to divide the rings
          * into cells, with the goal of keeping the cell width approximately the same as the cell height.
@@ -106,6 +137,9 @@ namespace spelunker::graphmaze {
          */
         static MazeGraph makeCircular(int radius);
 
+        /// As makeCircular, but emits a frozen MazeTemplate.
+        static MazeTemplate makeCircularTemplate(int radius);
+
         /**
          * Create a spherical maze of diameter rings. Note that we use diameter as opposed to radius to allow for
          * an odd number of rings.
@@ -114,6 +148,9 @@ namespace spelunker::graphmaze {
          */
         static MazeGraph makeSpherical(int diameter);
 
+        /// As makeSpherical, but emits a frozen MazeTemplate.
+        static MazeTemplate makeSphericalTemplate(int diameter);
+
         /**
          * Create a maze template representing an octagonal grid with diamonds at diagonals to the octagonal cells.
          * There are:
@@ -125,6 +162,9 @@ namespace spelunker::graphmaze {
          */
         static MazeGraph makeOctagonalGrid(int width, int height);
 
+        /// As makeOctagonalGrid, but emits a frozen MazeTemplate.
+        static MazeTemplate makeOctagonalGridTemplate(int width, int height);
+
         /**
          * Create a maze template representing an octagonal cylinder with diamonds at diagonals to the octagonal cells.
          * There are:
@@ -136,6 +176,9 @@ namespace spelunker::graphmaze {
          */
         static MazeGraph makeOctagonalCylinder(int width, int height);
 
+        /// As makeOctagonalCylinder, but emits a frozen MazeTemplate.
+        static MazeTemplate makeOctagonalCylinderTemplate(int width, int height);
+
         /**
          * Create a maze template representing an octagonal torus with diamonds at diagonals to the octagonal cells.
          * There are:
@@ -147,14 +190,24 @@ namespace spelunker::graphmaze {
          */
         static MazeGraph makeOctagonalTorus(int width, int height);
 
+        /// As makeOctagonalTorus, but emits a frozen MazeTemplate.
+        static MazeTemplate makeOctagonalTorusTemplate(int width, int height);
+
 
         /**
-         * Given a template for a maze, generate the seed for maze generation, which
+         * Given a generation context and a maze bound to a template, generate the seed for maze generation, which
          * contains all the information required by maze generators to generate complete meazes.
-         * @param tmplt the maze template
+         * The context is bound to the template of the maze and reset, and the maze is walled up, so that the passages
+         * are carved directly into it. Both reuse their storage.
+         * @param context the generation context, which must be for a template of the same size
+         * @param maze the maze into which to carve, which determines the template
+         * @param sink the sink to which the passages carved are reported
+         * @param rng the random engine from which the generator draws
          * @return the populated seed structure
+         * @throws UnsupportedMazeGeneration if the template is not of the size of the context
          */
-        static MazeSeed makeSeed(const MazeGraph &tmplt) noexcept;
+        template<typename T, typename S, typename R>
+        static BasicMazeSeed<T, S, R> makeSeed(GenerationContext &context, BasicCarvedMaze<T> &maze, S &sink, R &rng);
 
         /**
          * Select a random starting vertex in a graph.
@@ -163,13 +216,23 @@ namespace spelunker::graphmaze {
          */
         static vertex randomStartVertex(const MazeGraph &maze) noexcept;
 
+        /**
+         * Select a random starting vertex in a template.
+         * @param rng the random engine
+         * @param tmplt the template
+         * @return a random vertex in the template
+         */
+        template<typename R, typename T>
+        static vertex randomStartVertex(R &rng, const T &tmplt);
+
         /**
          * Get the unvisited neighbours of a vertex v in a maze seed.
          * @param seed the maze seed
          * @param v the vertex
          * @return a collection of the unvisited neighbours of v
          */
-        static VertexCollection unvisitedNeighbours(const MazeSeed &seed, const vertex &v);
+        template<typename T, typename S, typename R>
+        static VertexCollection unvisitedNeighbours(const BasicMazeSeed<T, S, R> &seed, const vertex &v);
 
         /**
          * Get the visited neighbours of a vertex v in a maze seed.
@@ -177,7 +240,8 @@ namespace spelunker::graphmaze {
          * @param v the vertex
          * @return a collection of the visited neighbours of v
          */
-        static VertexCollection visitedNeighbours(const MazeSeed &seed, const vertex &v);
+        template<typename T, typename S, typename R>
+        static VertexCollection visitedNeighbours(const BasicMazeSeed<T, S, R> &seed, const vertex &v);
 
         /**
          * Get the neighbours of a vertex v in a maze seed.
@@ -185,16 +249,44 @@ namespace spelunker::graphmaze {
          * @param v the vertex
          * @return a collection of all neighbours of v
          */
-        static VertexCollection neighbours(const MazeSeed &seed, const vertex &v);
+        template<typename T, typename S, typename R>
+        static VertexCollection neighbours(const BasicMazeSeed<T, S, R> &seed, const vertex &v);
+
+        /**
+         * As unvisitedNeighbours, but fill a buffer, e.g. one provided by the GenerationContext, instead of
+         * allocating a collection.
+         * @param seed the maze seed
+         * @param v the vertex
+         * @param out the buffer, which is cleared and then filled with the unvisited neighbours of v
+         */
+        template<typename T, typename S, typename R>
+        static void unvisitedNeighbours(const BasicMazeSeed<T, S, R> &seed, const vertex &v, VertexCollection &out);
+
+        /// As visitedNeighbours, but fill a buffer instead of allocating a collection.
+        template<typename T, typename S, typename R>
+        static void visitedNeighbours(const BasicMazeSeed<T, S, R> &seed, const vertex &v, VertexCollection &out);
+
+        /// As neighbours, but fill a buffer instead of allocating a collection.
+        template<typename T, typename S, typename R>
+        static void neighbours(const BasicMazeSeed<T, S, R> &seed, const vertex &v, VertexCollection &out);
 
         /**
-         * Given two vertices, add an edge between them in the maze.
-         * We do this through a method here because we want to copy the properties as well.
+         * Given two vertices, carve the template edge between them into a passage in the maze.
+         * This must find the edge amongst the slots of v1: if the edge index is already known, use carveEdge.
          * @param v1 first vertex in edge
          * @param v2 second vertex in edge
          * @param seed MazeSeed that contains template and final maze
          */
-        static void addEdge(vertex v1, vertex v2, MazeSeed &seed);
+        template<typename T, typename S, typename R>
+        static void addEdge(vertex v1, vertex v2, BasicMazeSeed<T, S, R> &seed);
+
+        /**
+         * Carve the template edge with the given index into a passage in the maze, and report it to the sink.
+         * @param e the index of the edge in the template
+         * @param seed MazeSeed that contains template and final maze
+         */
+        template<typename T, typename S, typename R>
+        static void carveEdge(std::size_t e, BasicMazeSeed<T, S, R> &seed);
 
         /**
          * A temporary way to output graphs for analysis, simply by listing their edges.
@@ -203,6 +295,13 @@ namespace spelunker::graphmaze {
          */
         static void outputGraph(std::ostream &out, const MazeGraph &graph);
 
+        /**
+         * As above, but for a carved maze, listing its passages.
+         * @param out the output stream
+         * @param maze the maze to output
+         */
+        static void outputGraph(std::ostream &out, const CarvedMaze &maze);
+
         /**
          * Get the candidate function in the graph used by the binary tree and sidewinder
          * algorithms to dictate directions at cells. This is an optional parameter, so
@@ -218,7 +317,7 @@ namespace spelunker::graphmaze {
          * @param graph the graph
          * @return a collection of the ranker functions
          */
-        static const std::vector<GridRankerMap> &getRankerFunctions(const MazeGraph &graph);
+        static const std::vector<GridRanker> &getRankerFunctions(const MazeGraph &graph);
 
         /**
          * Get the entire graph info.
@@ -233,9 +332,10 @@ namespace spelunker::graphmaze {
          * @param seed the maze seed
          * @param v the vertex to examine
          * @param visited true if we want the visited neighbours of v, and false otherwise
-         * @return the corresponding neighbours of v
+         * @param out the buffer to clear and fill with the corresponding neighbours of v
          */
-        static VertexCollection nbrs(const MazeSeed &seed, const vertex &v, const bool visited);
+        template<typename T, typename S, typename R>
+        static void nbrs(const BasicMazeSeed<T, S, R> &seed, const vertex &v, const bool visited, VertexCollection &out);
 
         /**
          * For a circular graph, calculate the number of cells in each ring using an adaptive
@@ -264,11 +364,20 @@ namespace spelunker::graphmaze {
          * @param height the height of the grid
          * @param xorientation the behaviour of rows
          * @param yorientation the behaviour of columns
-         * @return a MazeGraph initialized with the appropriate edges and properties
+         * @return a builder describing the appropriate vertices, edges, and properties
          */
-        static MazeGraph makeGrid(int width, int height,
+        static MazeTemplateBuilder buildGrid(int width, int height,
                 types::AxialOrientation xorientation, types::AxialOrientation yorientation);
 
+        /// Describe a grid from a mask: see makeGridFromMask.
+        static MazeTemplateBuilder buildGridFromMask(std::istream &str);
+
+        /// Describe a circular template: see makeCircular.
+        static MazeTemplateBuilder buildCircular(int radius);
+
+        /// Describe a spherical template: see makeSpherical.
+        static MazeTemplateBuilder buildSpherical(int diameter);
+
         /**
          * Create a tiling of width by height octagonal tiles. Note that between each 2x2 configuration of octagonal
          * tiles is a diamond tile, so there are tiles connected to octagonal tiles
@@ -283,27 +392,10 @@ namespace spelunker::graphmaze {
          * @param width the octagonal tile width
          * @param height the octagonal tile height
          * @param xorientation the
-         * @return the graph representing this
-         */
-        static MazeGraph makeOctagonalGrid(int width, int height,
-                                       types::AxialOrientation xorientation, types::AxialOrientation yorientation);
-
-        /**
-         * Given a template maze, create the initial maze to begin maze generation.
-         * This comprises a maze simply consisting of the vertices in the template maze,
-         * and no edges, which will be added by the maze generation technique.
-         * @param tmplt the template maze
-         * @return the initialized maze graph of vertices
+         * @return a builder describing this
          */
-        static MazeGraph createInitialMaze(const MazeGraph &tmplt) noexcept;
-
-        /**
-         * Given a maze template, create a structure representing whether or not a vertex has been
-         * visited. All vertices are initialized as unvisited.
-         * @param tmplt the template maze
-         * @return an indexable structure over all vertices indicating whether or not they have been visited
-         */
-        static UnvisitedVertices initializeUnvisitedVertices(const MazeGraph &tmplt) noexcept;
+        static MazeTemplateBuilder buildOctagonalGrid(int width, int height,
+                types::AxialOrientation xorientation, types::AxialOrientation yorientation);
 
         /**
          * Calculate and return the number of vertices for a MazeGraph.
@@ -313,6 +405,88 @@ namespace spelunker::graphmaze {
          */
         static int numVertices(const MazeGraph &maze);
     };
-}
-
 
+    template<typename T, typename S, typename R>
+    BasicMazeSeed<T, S, R> GraphUtils::makeSeed(GenerationContext &context, BasicCarvedMaze<T> &maze,
+                                                S &sink, R &rng) {
+        const auto &tmplt = maze.getTemplate();
+        context.bind(tmplt);
+        context.reset();
+        maze.reset(tmplt);
+        return BasicMazeSeed<T, S, R> {
+            tmplt,
+            maze,
+            tmplt.numVertices(),
+            context.getUnvisited(),
+            context,
+            sink,
+            rng
+        };
+    }
+
+    template<typename R, typename T>
+    vertex GraphUtils::randomStartVertex(R &rng, const T &tmplt) {
+        return math::URBGUtils::randomRange(rng, tmplt.numVertices());
+    }
+
+    template<typename T, typename S, typename R>
+    VertexCollection GraphUtils::unvisitedNeighbours(const BasicMazeSeed<T, S, R> &seed, const vertex &v) {
+        VertexCollection vc;
+        nbrs(seed, v, false, vc);
+        return vc;
+    }
+
+    template<typename T, typename S, typename R>
+    VertexCollection GraphUtils::visitedNeighbours(const BasicMazeSeed<T, S, R> &seed, const vertex &v) {
+        VertexCollection vc;
+        nbrs(seed, v, true, vc);
+        return vc;
+    }
+
+    template<typename T, typename S, typename R>
+    VertexCollection GraphUtils::neighbours(const BasicMazeSeed<T, S, R> &seed, const vertex &v) {
+        VertexCollection neighbours;
+        neighbours.reserve(seed.tmplt.degree(v));
+        GraphUtils::neighbours(seed, v, neighbours);
+        return neighbours;
+    }
+
+    template<typename T, typename S, typename R>
+    void GraphUtils::unvisitedNeighbours(const BasicMazeSeed<T, S, R> &seed, const vertex &v, VertexCollection &out) {
+        nbrs(seed, v, false, out);
+    }
+
+    template<typename T, typename S, typename R>
+    void GraphUtils::visitedNeighbours(const BasicMazeSeed<T, S, R> &seed, const vertex &v, VertexCollection &out) {
+        nbrs(seed, v, true, out);
+    }
+
+    template<typename T, typename S, typename R>
+    void GraphUtils::neighbours(const BasicMazeSeed<T, S, R> &seed, const vertex &v, VertexCollection &out) {
+        out.clear();
+        seed.tmplt.forEachNeighbour(v, [&out](const vertex t, std::size_t) {
+            out.emplace_back(t);
+        });
+    }
+
+    template<typename T, typename S, typename R>
+    void GraphUtils::addEdge(vertex v1, vertex v2, BasicMazeSeed<T, S, R> &seed) {
+        carveEdge(seed.tmplt.findEdge(v1, v2).value(), seed);
+    }
+
+    template<typename T, typename S, typename R>
+    void GraphUtils::carveEdge(const std::size_t e, BasicMazeSeed<T, S, R> &seed) {
+        seed.maze.carve(e);
+        if constexpr (S::Enabled)
+            seed.sink.onCarve(CarveEvent{e, seed.tmplt.edgeInfo(e)});
+    }
+
+    template<typename T, typename S, typename R>
+    void GraphUtils::nbrs(const BasicMazeSeed<T, S, R> &seed, const vertex &v, const bool visited, VertexCollection &out) {
+        out.clear();
+        seed.tmplt.forEachNeighbour(v, [&seed, &out, visited](const vertex t, std::size_t) {
+            if (seed.unvisited.isUnvisited(t) != visited)
+                out.emplace_back(t);
+        });
+    }
+}
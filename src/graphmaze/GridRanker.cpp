@@ -0,0 +1,116 @@
+/**
+ * GridRanker.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include <types/Exceptions.h>
+
+#include "MazeGraph.h"
+#include "GridRanker.h"
+
+namespace spelunker::graphmaze {
+    static_assert(std::is_same_v<vertex, std::size_t>, "GridRanker assumes that vertices are std::size_t.");
+
+    GridRanker::GridRanker()
+        : layout{Layout::DENSE}, width{0}, height{0}, base{0} {}
+
+    GridRanker GridRanker::dense(const int width, const int height, const std::size_t base) {
+        if (width < 0 || height < 0)
+            throw types::IllegalDimensions(width, height);
+
+        GridRanker ranker;
+        ranker.width = width;
+        ranker.height = height;
+        ranker.base = base;
+        return ranker;
+    }
+
+    GridRanker GridRanker::rings(const std::vector<int> &rowSizes, const std::size_t base) {
+        GridRanker ranker;
+        ranker.layout = Layout::RINGS;
+        ranker.height = static_cast<int>(rowSizes.size());
+        ranker.base = base;
+
+        ranker.rowOffsets.reserve(rowSizes.size() + 1);
+        ranker.rowOffsets.emplace_back(0);
+        for (const auto size: rowSizes)
+            ranker.rowOffsets.emplace_back(ranker.rowOffsets.back() + size);
+        return ranker;
+    }
+
+    GridRanker GridRanker::sparse(const std::vector<std::pair<std::pair<int, int>, std::size_t>> &entries) {
+        GridRanker ranker;
+        ranker.layout = Layout::SPARSE;
+
+        std::vector<std::size_t> order(entries.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&entries](const auto i, const auto j) {
+            return pack(entries[i].first.first, entries[i].first.second) <
+                   pack(entries[j].first.first, entries[j].first.second);
+        });
+
+        ranker.keys.reserve(entries.size());
+        ranker.values.reserve(entries.size());
+        for (const auto i: order) {
+            const auto &[coords, v] = entries[i];
+            ranker.keys.emplace_back(pack(coords.first, coords.second));
+            ranker.values.emplace_back(v);
+        }
+        return ranker;
+    }
+
+    std::optional<std::size_t> GridRanker::find(const int x, const int y) const noexcept {
+        switch (layout) {
+            case Layout::DENSE:
+                if (x < 0 || x >= width || y < 0 || y >= height)
+                    return std::nullopt;
+                return base + static_cast<std::size_t>(y) * width + x;
+
+            case Layout::RINGS:
+                if (x < 0 || x >= height || y < 0 || rowOffsets[x] + y >= rowOffsets[x + 1])
+                    return std::nullopt;
+                return base + rowOffsets[x] + y;
+
+            case Layout::SPARSE: {
+                const auto key = pack(x, y);
+                const auto iter = std::lower_bound(keys.cbegin(), keys.cend(), key);
+                if (iter == keys.cend() || *iter != key)
+                    return std::nullopt;
+                return values[iter - keys.cbegin()];
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::size_t GridRanker::at(const int x, const int y) const {
+        const auto v = find(x, y);
+        if (!v.has_value())
+            throw types::OutOfBoundsCoordinates(x, y);
+        return *v;
+    }
+
+    std::size_t GridRanker::size() const noexcept {
+        switch (layout) {
+            case Layout::DENSE:
+                return static_cast<std::size_t>(width) * height;
+            case Layout::RINGS:
+                return rowOffsets.back();
+            case Layout::SPARSE:
+                return keys.size();
+        }
+        return 0;
+    }
+
+    std::uint64_t GridRanker::pack(const int x, const int y) noexcept {
+        // Sort by y and then by x, i.e. in row-major order.
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(y)) << 32) | static_cast<std::uint32_t>(x);
+    }
+}
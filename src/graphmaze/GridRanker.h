@@ -0,0 +1,101 @@
+/**
+ * GridRanker.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Maps the coordinates of the cells of a tessellation to the vertices that represent them.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace spelunker::graphmaze {
+    /// A ranker used to map (x,y) coordinates into vertices.
+    /**
+     * For regular tessellations, the mapping from coordinates to vertices is pure index arithmetic, so we
+     * store no per-cell data at all. There are three layouts:
+     * 1. Dense: a width by height rectangle in row-major order, i.e. (x,y) maps to base + y * width + x.
+     * 2. Rings: a sequence of rows (rings) of varying lengths, laid out one after the other, so that (row,col)
+     *    maps to base + (number of cells in rows before row) + col. This covers circular and spherical templates.
+     * 3. Sparse: an arbitrary set of coordinates, e.g. a grid with a mask, stored as a sorted array of packed
+     *    coordinates alongside the vertices, and searched by binary search.
+     *
+     * Vertices are represented as std::size_t, which is the vertex descriptor of a MazeGraph.
+     */
+    class GridRanker final {
+    public:
+        /// An empty ranker, in which no coordinates exist.
+        GridRanker();
+
+        /**
+         * Create a ranker for a width by height rectangle of cells in row-major order.
+         * @param width the width of the rectangle
+         * @param height the height of the rectangle
+         * @param base the vertex of the cell at (0,0)
+         * @return the ranker
+         */
+        static GridRanker dense(int width, int height, std::size_t base = 0);
+
+        /**
+         * Create a ranker for a sequence of rows of varying lengths in row-major order.
+         * The coordinates are (row, col), with 0 <= col < rowSizes[row].
+         * @param rowSizes the number of cells in each row
+         * @param base the vertex of the cell at (0,0)
+         * @return the ranker
+         */
+        static GridRanker rings(const std::vector<int> &rowSizes, std::size_t base = 0);
+
+        /**
+         * Create a ranker for an arbitrary set of coordinates.
+         * @param entries the coordinates and their vertices, in any order
+         * @return the ranker
+         */
+        static GridRanker sparse(const std::vector<std::pair<std::pair<int, int>, std::size_t>> &entries);
+
+        /**
+         * Find the vertex at the given coordinates, if there is one.
+         * @param x the first coordinate
+         * @param y the second coordinate
+         * @return the vertex, or none if there is no cell at (x,y)
+         */
+        std::optional<std::size_t> find(int x, int y) const noexcept;
+
+        /**
+         * Get the vertex at the given coordinates.
+         * @param x the first coordinate
+         * @param y the second coordinate
+         * @return the vertex
+         * @throws types::OutOfBoundsCoordinates if there is no cell at (x,y)
+         */
+        std::size_t at(int x, int y) const;
+
+        /// The number of cells covered by this ranker.
+        std::size_t size() const noexcept;
+
+    private:
+        enum class Layout {
+            DENSE,
+            RINGS,
+            SPARSE,
+        };
+
+        Layout layout;
+        int width;
+        int height;
+        std::size_t base;
+
+        /// For RINGS, rowOffsets[row] is the number of cells in the rows before row, with a final total entry.
+        std::vector<std::size_t> rowOffsets;
+
+        /// For SPARSE, the sorted packed coordinates and their corresponding vertices.
+        std::vector<std::uint64_t> keys;
+        std::vector<std::size_t> values;
+
+        static std::uint64_t pack(int x, int y) noexcept;
+    };
+}
@@ -0,0 +1,39 @@
+/**
+ * GrowingTreeMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include <math/DrawBuffer.h>
+
+#include "GraphUtils.h"
+#include "GrowingTreeMazeGenerator.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+
+namespace spelunker::graphmaze {
+    NewestOrRandomPolicy::NewestOrRandomPolicy(const double newestRatio)
+        : newestRatio{newestRatio} {
+        if (!(newestRatio >= 0.0 && newestRatio <= 1.0))
+            throw std::invalid_argument("newest ratio must be in [0,1], but is " + std::to_string(newestRatio));
+    }
+
+    template vertex GrowingTreeMazeGenerator<NewestPolicy>::grow(MazeSeed&, const NewestPolicy&);
+    template vertex GrowingTreeMazeGenerator<NewestPolicy>::grow(ObservedMazeSeed&, const NewestPolicy&);
+    template vertex GrowingTreeMazeGenerator<NewestPolicy>::grow(SeededMazeSeed&, const NewestPolicy&);
+    template vertex GrowingTreeMazeGenerator<OldestPolicy>::grow(MazeSeed&, const OldestPolicy&);
+    template vertex GrowingTreeMazeGenerator<OldestPolicy>::grow(ObservedMazeSeed&, const OldestPolicy&);
+    template vertex GrowingTreeMazeGenerator<OldestPolicy>::grow(SeededMazeSeed&, const OldestPolicy&);
+    template vertex GrowingTreeMazeGenerator<RandomPolicy>::grow(MazeSeed&, const RandomPolicy&);
+    template vertex GrowingTreeMazeGenerator<RandomPolicy>::grow(ObservedMazeSeed&, const RandomPolicy&);
+    template vertex GrowingTreeMazeGenerator<RandomPolicy>::grow(SeededMazeSeed&, const RandomPolicy&);
+    template vertex GrowingTreeMazeGenerator<NewestOrRandomPolicy>::grow(MazeSeed&, const NewestOrRandomPolicy&);
+    template vertex GrowingTreeMazeGenerator<NewestOrRandomPolicy>::grow(ObservedMazeSeed&,
+                                                                        const NewestOrRandomPolicy&);
+    template vertex GrowingTreeMazeGenerator<NewestOrRandomPolicy>::grow(SeededMazeSeed&,
+                                                                        const NewestOrRandomPolicy&);
+}
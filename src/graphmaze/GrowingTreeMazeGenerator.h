@@ -0,0 +1,220 @@
+/**
+ * GrowingTreeMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#include <math/DrawBuffer.h>
+
+#include "GraphUtils.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeSeed.h"
+
+namespace spelunker::graphmaze {
+
+    /// Always grow from the newest cell, which gives the long corridors of a depth-first search.
+    struct NewestPolicy final {
+        static constexpr bool KeepsOrder = true;
+
+        template<typename R>
+        inline std::size_t select(math::DrawBuffer<R>&, std::size_t, const std::size_t size) const noexcept {
+            return size - 1;
+        }
+    };
+
+    /// Always grow from the oldest cell that can still grow, which fills in the maze around the start.
+    struct OldestPolicy final {
+        static constexpr bool KeepsOrder = true;
+
+        template<typename R>
+        inline std::size_t select(math::DrawBuffer<R>&, const std::size_t head, std::size_t) const noexcept {
+            return head;
+        }
+    };
+
+    /// Grow from a random cell, which gives the short dead ends of the simplified Prim's algorithm.
+    struct RandomPolicy final {
+        static constexpr bool KeepsOrder = false;
+
+        template<typename R>
+        inline std::size_t select(math::DrawBuffer<R> &draws, const std::size_t head, const std::size_t size) const {
+            return head + draws.below(size - head);
+        }
+    };
+
+    /// Grow from the newest cell with a given probability, and from a random cell otherwise.
+    struct NewestOrRandomPolicy final {
+        static constexpr bool KeepsOrder = true;
+
+        /**
+         * Create a policy.
+         * @param newestRatio the probability of growing from the newest cell
+         * @throws invalid_argument if the ratio is not in [0,1]
+         */
+        explicit NewestOrRandomPolicy(double newestRatio = 0.5);
+
+        inline double getNewestRatio() const noexcept { return newestRatio; }
+
+        /// Select the newest cell, or any cell in [head,size), which may have been removed and must be checked.
+        template<typename R>
+        inline std::size_t select(math::DrawBuffer<R> &draws, const std::size_t head, const std::size_t size) const {
+            return draws.probability() < newestRatio ? size - 1 : head + draws.below(size - head);
+        }
+
+    private:
+        double newestRatio;
+    };
+
+    /**
+     * This is a MazeGenerator that works based on the growing tree algorithm, which keeps a list of the cells in the
+     * maze that may still have unvisited neighbours, and repeatedly selects one of them by a policy and carves a
+     * passage from it to a random unvisited neighbour, which joins the list. A cell with no unvisited neighbours
+     * is removed from the list when it is selected.
+     *
+     * The policy is a template parameter, so that its selection inlines into the loop: NewestPolicy gives the
+     * DFSMazeGenerator, and RandomPolicy gives the PrimMazeGenerator, both of which run on this engine. A policy has
+     * a member select(draws, head, size), which returns the index of the next cell amongst positions [head, size) of
+     * the list, making any random draws from the DrawBuffer, and a constant KeepsOrder, which is false if the policy
+     * does not depend on the order of the list, so that a cell may be removed from its middle by moving the last
+     * cell into its place.
+     *
+     * Every cell joins the list once, so the list is a flat buffer from the GenerationContext that never wraps:
+     * the newest cell is at the back, and removing the oldest cell advances a head index. For the policies that
+     * keep the order, a cell removed from the middle of the list is marked as removed, and the marked cells are
+     * compacted out once they make up half the list, so that selection and removal take amortised constant time.
+     * @tparam Policy the selection policy
+     */
+    template<typename Policy>
+    class GrowingTreeMazeGenerator final : public GenericMazeGenerator<GrowingTreeMazeGenerator<Policy>> {
+    public:
+        explicit GrowingTreeMazeGenerator(Policy policy = Policy{}) noexcept : policy{policy} {}
+        virtual ~GrowingTreeMazeGenerator() final = default;
+
+        inline const Policy &getPolicy() const noexcept { return policy; }
+
+        /**
+         * Grow a maze over a seed from a random vertex by a given policy, for the generators that run on this engine.
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @param policy the selection policy
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        static vertex grow(BasicMazeSeed<T, S, R> &seed, const Policy &policy);
+
+    private:
+        Policy policy;
+
+        /// Marks a removed cell in the middle of the list.
+        static constexpr vertex Removed = std::numeric_limits<vertex>::max();
+
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        inline vertex carveOver(BasicMazeSeed<T, S, R> &seed) const {
+            return grow(seed, policy);
+        }
+
+        friend class GenericMazeGenerator<GrowingTreeMazeGenerator<Policy>>;
+    };
+
+    template<typename Policy>
+    template<typename T, typename S, typename R>
+    vertex GrowingTreeMazeGenerator<Policy>::grow(BasicMazeSeed<T, S, R> &seed, const Policy &policy) {
+        auto &cells = seed.context.getVertexBuffer();
+        auto &nbrs = seed.context.getNeighbourBuffer();
+        std::size_t head = 0;
+        std::size_t removed = 0;
+
+        // A step makes a draw or two, so draw the random words in blocks.
+        math::DrawBuffer<R> draws{seed.rng};
+
+        const auto start = GraphUtils::randomStartVertex(seed.rng, seed.tmplt);
+        seed.unvisited.visit(start);
+        cells.emplace_back(start);
+
+        while (head < cells.size()) {
+            const auto i = policy.select(draws, head, cells.size());
+            const auto v = cells[i];
+            if constexpr (Policy::KeepsOrder) {
+                if (v == Removed)
+                    continue;
+            }
+
+            // If v has no unvisited neighbours, remove it.
+            GraphUtils::unvisitedNeighbours(seed, v, nbrs);
+            if (nbrs.empty()) {
+                if (i + 1 == cells.size()) {
+                    cells.pop_back();
+                } else if constexpr (!Policy::KeepsOrder) {
+                    cells[i] = cells.back();
+                    cells.pop_back();
+                } else if (i == head) {
+                    ++head;
+                } else {
+                    cells[i] = Removed;
+                    ++removed;
+                }
+
+                if constexpr (Policy::KeepsOrder) {
+                    // Keep a live cell at each end of the list, and compact the list once half of it is removed.
+                    while (head < cells.size() && cells.back() == Removed) {
+                        cells.pop_back();
+                        --removed;
+                    }
+                    while (head < cells.size() && cells[head] == Removed) {
+                        ++head;
+                        --removed;
+                    }
+                    if (2 * removed > cells.size() - head) {
+                        std::size_t j = 0;
+                        for (auto k = head; k < cells.size(); ++k)
+                            if (cells[k] != Removed)
+                                cells[j++] = cells[k];
+                        cells.resize(j);
+                        head = 0;
+                        removed = 0;
+                    }
+                }
+                continue;
+            }
+
+            // Carve a passage to a random unvisited neighbour, which joins the list.
+            const auto u = draws.element(nbrs);
+            GraphUtils::addEdge(v, u, seed);
+            seed.unvisited.visit(u);
+            cells.emplace_back(u);
+        }
+
+        return start;
+    }
+
+    /// The generators over a MazeTemplate are instantiated once, in GrowingTreeMazeGenerator.cpp.
+    extern template vertex GrowingTreeMazeGenerator<NewestPolicy>::grow(MazeSeed&, const NewestPolicy&);
+    extern template vertex GrowingTreeMazeGenerator<NewestPolicy>::grow(ObservedMazeSeed&, const NewestPolicy&);
+    extern template vertex GrowingTreeMazeGenerator<NewestPolicy>::grow(SeededMazeSeed&, const NewestPolicy&);
+    extern template vertex GrowingTreeMazeGenerator<OldestPolicy>::grow(MazeSeed&, const OldestPolicy&);
+    extern template vertex GrowingTreeMazeGenerator<OldestPolicy>::grow(ObservedMazeSeed&, const OldestPolicy&);
+    extern template vertex GrowingTreeMazeGenerator<OldestPolicy>::grow(SeededMazeSeed&, const OldestPolicy&);
+    extern template vertex GrowingTreeMazeGenerator<RandomPolicy>::grow(MazeSeed&, const RandomPolicy&);
+    extern template vertex GrowingTreeMazeGenerator<RandomPolicy>::grow(ObservedMazeSeed&, const RandomPolicy&);
+    extern template vertex GrowingTreeMazeGenerator<RandomPolicy>::grow(SeededMazeSeed&, const RandomPolicy&);
+    extern template vertex GrowingTreeMazeGenerator<NewestOrRandomPolicy>::grow(MazeSeed&,
+                                                                               const NewestOrRandomPolicy&);
+    extern template vertex GrowingTreeMazeGenerator<NewestOrRandomPolicy>::grow(ObservedMazeSeed&,
+                                                                               const NewestOrRandomPolicy&);
+    extern template vertex GrowingTreeMazeGenerator<NewestOrRandomPolicy>::grow(SeededMazeSeed&,
+                                                                               const NewestOrRandomPolicy&);
+}
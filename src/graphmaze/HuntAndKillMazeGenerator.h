@@ -6,17 +6,118 @@
 
 #pragma once
 
+#include <cstddef>
+
+#include <math/SmallRandom.h>
+
+#include "FrontierSet.h"
+#include "GraphUtils.h"
 #include "MazeGenerator.h"
 #include "MazeGraph.h"
+#include "MazeSeed.h"
 
 namespace spelunker::graphmaze {
 
-    class HuntAndKillMazeGenerator final : public MazeGenerator {
+    /**
+     * This is a MazeGenerator that works based on the hunt-and-kill algorithm, which carves a random walk through
+     * unvisited vertices until it reaches a dead end, and then hunts for an unvisited vertex with a visited
+     * neighbour, joins the two, and walks again from there.
+     *
+     * The candidates for the hunt, i.e. the unvisited vertices with a visited neighbour, are kept in the FrontierSet
+     * of the GenerationContext as the walks visit vertices, so that a hunt is a search of the frontier rather than a
+     * test of the neighbours of every unvisited vertex. The order of the hunt is one of:
+     * 1. ROW_SCAN: the classic hunt, which takes the lowest-indexed candidate, i.e. the first in a scan of the rows
+     *    of a grid. A walk may add candidates behind the scan, so each hunt resumes at the lowest candidate.
+     * 2. SWEEP: each hunt takes the first candidate at or after the vertex found by the previous hunt, wrapping
+     *    around to the first vertex once it passes the last, so that the hunts sweep the template in passes.
+     */
+    class HuntAndKillMazeGenerator final : public GenericMazeGenerator<HuntAndKillMazeGenerator> {
     public:
-        HuntAndKillMazeGenerator() = default;
+        /// The order in which to hunt for the start of the next walk.
+        enum class HuntOrder {
+            ROW_SCAN,
+            SWEEP,
+        };
+
+        explicit HuntAndKillMazeGenerator(HuntOrder order = HuntOrder::ROW_SCAN) noexcept : order{order} {}
         virtual ~HuntAndKillMazeGenerator() final = default;
 
-        virtual std::pair<const MazeGraph, const vertex> generate(const MazeGraph &tmplt) const final;
+        inline HuntOrder getHuntOrder() const noexcept { return order; }
+
+    private:
+        HuntOrder order;
+
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        friend class GenericMazeGenerator<HuntAndKillMazeGenerator>;
     };
-}
 
+    template<typename T, typename S, typename R>
+    vertex HuntAndKillMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
+
+        // Get a random starting cell.
+        const auto start = GraphUtils::randomStartVertex(seed.rng, seed.tmplt);
+        auto v = start;
+
+        auto &nbrs = seed.context.getNeighbourBuffer();
+        auto &frontier = seed.context.getFrontier();
+        frontier.reset(seed.numVertices);
+
+        // The vertex from which to hunt: no candidate lies before it for ROW_SCAN, and it only advances for SWEEP,
+        // unless it wraps around.
+        std::size_t cursor = 0;
+
+        while (true) {
+            // Continue to carve a random walk until we can no longer do so.
+            while (true) {
+                seed.unvisited.visit(v);
+                frontier.erase(v);
+
+                // Get the unvisited neighbours of v, which are now candidates for the hunt, and pick one.
+                GraphUtils::unvisitedNeighbours(seed, v, nbrs);
+                if (nbrs.empty())
+                    break;
+
+                for (const auto u: nbrs) {
+                    frontier.insert(u);
+                    if (order == HuntOrder::ROW_SCAN && u < cursor)
+                        cursor = u;
+                }
+
+                const auto unvisitedNbr = math::SmallRandom::element(seed.rng, nbrs);
+                GraphUtils::addEdge(v, unvisitedNbr, seed);
+                v = unvisitedNbr;
+            }
+
+            // Hunt for the next candidate, and add it to the maze through a visited neighbour.
+            v = frontier.findFirst(cursor);
+            if (v == FrontierSet::npos && order == HuntOrder::SWEEP && cursor > 0)
+                v = frontier.findFirst();
+            if (v == FrontierSet::npos)
+                break;
+            cursor = v;
+
+            GraphUtils::visitedNeighbours(seed, v, nbrs);
+            const auto visitedNbr = math::SmallRandom::element(seed.rng, nbrs);
+            GraphUtils::addEdge(v, visitedNbr, seed);
+        }
+
+        // Now we have covered all vertices and added them to the maze.
+        return start;
+    }
+
+    /// The generator over a MazeTemplate is instantiated once, in HuntAndKillMazeGenerator.cpp.
+    extern template vertex HuntAndKillMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex HuntAndKillMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex HuntAndKillMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
@@ -0,0 +1,64 @@
+/**
+ * ImplicitGridTemplate.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cassert>
+#include <deque>
+#include <optional>
+
+#include <types/AxialOrientation.h>
+#include <types/Direction.h>
+#include <types/Exceptions.h>
+#include <types/Tessellations.h>
+
+#include "GridRanker.h"
+#include "ImplicitGridTemplate.h"
+#include "MazeGraph.h"
+
+namespace spelunker::graphmaze {
+    ImplicitGridTemplate::ImplicitGridTemplate(const int width, const int height,
+                                               const types::AxialOrientation xorientation,
+                                               const types::AxialOrientation yorientation)
+        : width{static_cast<std::size_t>(width)}, height{static_cast<std::size_t>(height)},
+          xorientation{xorientation}, yorientation{yorientation} {
+        if (width <= 0 || height <= 0
+            || (xorientation != types::AxialOrientation::DISCONNECTED && width < 3)
+            || (yorientation != types::AxialOrientation::DISCONNECTED && height < 3))
+            throw types::IllegalDimensions{width, height};
+
+        info.width = this->width;
+        info.height = this->height;
+        info.type = types::TessellationType::GRID;
+        info.binaryTreeCandidates = [](int) {
+            return std::deque<types::Direction>{types::Direction::EAST, types::Direction::SOUTH};
+        };
+        info.gridRankers = {GridRanker::dense(width, height)};
+    }
+
+    std::optional<std::size_t> ImplicitGridTemplate::findEdge(const vertex v1, const vertex v2) const noexcept {
+        for (const auto d: {types::Direction::NORTH, types::Direction::EAST,
+                            types::Direction::SOUTH, types::Direction::WEST}) {
+            vertex t{};
+            std::size_t e{};
+            if (step(v1, d, t, e) && t == v2)
+                return e;
+        }
+        return std::nullopt;
+    }
+
+    EdgeInfo ImplicitGridTemplate::edgeInfo(const std::size_t e) const noexcept {
+        const auto cells = numVertices();
+        vertex t{};
+        std::size_t idx{};
+        if (e < cells) {
+            [[maybe_unused]] const auto exists = step(e, types::Direction::EAST, t, idx);
+            assert(exists);
+            return EdgeInfo{e, types::Direction::EAST, t, types::Direction::WEST};
+        }
+        [[maybe_unused]] const auto exists = step(e - cells, types::Direction::SOUTH, t, idx);
+        assert(exists);
+        return EdgeInfo{e - cells, types::Direction::SOUTH, t, types::Direction::NORTH};
+    }
+}
@@ -0,0 +1,190 @@
+/**
+ * ImplicitGridTemplate.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A template for the grid-based tessellations that computes its structure on the fly instead of storing it.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include <types/AxialOrientation.h>
+#include <types/Direction.h>
+
+#include "MazeGraph.h"
+
+namespace spelunker::graphmaze {
+    /// A grid, cylinder, torus, Mobius strip, Klein bottle, or projective plane, computed by index arithmetic.
+    /**
+     * This describes the same vertices and edges as GraphUtils::makeGrid and its relatives, with the same vertex
+     * numbering (row-major) and the same neighbour order (by target), but stores nothing per cell. It offers the
+     * same interface as a MazeTemplate for the generators, so a generator run over it needs only the visited set
+     * and the carved edge bitvector, which allows for mazes with billions of cells.
+     *
+     * Edges are numbered by the cell that owns them: the EAST edge of the cell at vertex v is v, and its SOUTH edge
+     * is numVertices() + v. Cells on an edge of a disconnected axis have no edge there, so not every index in
+     * [0, numEdges()) is an edge: numEdges() is the size of the edge index space, which is what sizes a bitvector.
+     * (In the projective plane, the SOUTH edges of the two bottom corners would duplicate EAST / WEST edges, so, as in
+     * a MazeTemplate, which collapses parallel edges, they do not exist.)
+     *
+     * An axis that loops must be at least 3 cells long so that the looping edges are not parallel to other edges.
+     */
+    class ImplicitGridTemplate final {
+    public:
+        /**
+         * Create a grid-based template.
+         * @param width the width of the grid
+         * @param height the height of the grid
+         * @param xorientation the behaviour of rows
+         * @param yorientation the behaviour of columns
+         * @throws IllegalDimensions if the grid is empty or a looped axis is shorter than 3
+         */
+        ImplicitGridTemplate(int width, int height,
+                types::AxialOrientation xorientation, types::AxialOrientation yorientation);
+
+        inline std::size_t numVertices() const noexcept { return width * height; }
+
+        /// The size of the edge index space: see the class description.
+        inline std::size_t numEdges() const noexcept { return 2 * width * height; }
+
+        inline std::size_t maxDegree() const noexcept { return 4; }
+        inline std::size_t numVertexTypes() const noexcept { return 1; }
+
+        inline std::size_t degree(const vertex v) const noexcept {
+            std::size_t d = 0;
+            forEachNeighbour(v, [&d](vertex, std::size_t) { ++d; });
+            return d;
+        }
+
+        /**
+         * Visit every neighbour of v, in order of target.
+         * @tparam F a callable taking (vertex target, std::size_t edgeIndex)
+         * @param v the vertex
+         * @param f the callable
+         */
+        template<typename F>
+        inline void forEachNeighbour(const vertex v, F &&f) const {
+            std::pair<vertex, std::size_t> nbrs[4];
+            std::size_t n = 0;
+            for (const auto d: {types::Direction::NORTH, types::Direction::EAST,
+                                types::Direction::SOUTH, types::Direction::WEST}) {
+                vertex t;
+                std::size_t e;
+                if (!step(v, d, t, e))
+                    continue;
+
+                // Insertion sort by target: there are at most four.
+                auto i = n++;
+                for (; i > 0 && nbrs[i - 1].first > t; --i)
+                    nbrs[i] = nbrs[i - 1];
+                nbrs[i] = {t, e};
+            }
+            for (std::size_t i = 0; i < n; ++i)
+                f(nbrs[i].first, nbrs[i].second);
+        }
+
+        /**
+         * Visit the neighbour of v in direction d, if there is one.
+         * @tparam F a callable taking (vertex target, std::size_t edgeIndex)
+         * @param v the vertex
+         * @param d the direction
+         * @param f the callable
+         */
+        template<typename F>
+        inline void forEachNeighbourInDirection(const vertex v, const types::Direction d, F &&f) const {
+            vertex t;
+            std::size_t e;
+            if (step(v, d, t, e))
+                f(t, e);
+        }
+
+        /// Find the index of the edge between two vertices, if there is one.
+        std::optional<std::size_t> findEdge(vertex v1, vertex v2) const noexcept;
+
+        inline VertexInfo vertexInfo(vertex) const noexcept { return VertexInfo{0}; }
+
+        /// The properties of an edge, which must exist.
+        EdgeInfo edgeInfo(std::size_t e) const noexcept;
+
+        inline const GraphInfo &graphInfo() const noexcept { return info; }
+
+        inline types::AxialOrientation getXOrientation() const noexcept { return xorientation; }
+        inline types::AxialOrientation getYOrientation() const noexcept { return yorientation; }
+
+    private:
+        std::size_t width;
+        std::size_t height;
+        types::AxialOrientation xorientation;
+        types::AxialOrientation yorientation;
+        GraphInfo info;
+
+        /**
+         * Find the neighbour of v in direction d.
+         * @param v the vertex
+         * @param d the direction
+         * @param t set to the neighbour, if there is one
+         * @param e set to the index of the edge, if there is one
+         * @return true if there is a neighbour in direction d, and false otherwise
+         */
+        inline bool step(const vertex v, const types::Direction d, vertex &t, std::size_t &e) const noexcept {
+            const auto x = v % width;
+            const auto y = v / width;
+            const auto cells = width * height;
+            const auto xflip = xorientation == types::AxialOrientation::REVERSE_LOOPED;
+            const auto yflip = yorientation == types::AxialOrientation::REVERSE_LOOPED;
+
+            // In the projective plane, the looping SOUTH edges of the bottom corners duplicate looping EAST / WEST
+            // edges, so they are omitted.
+            const auto corner = xflip && yflip && (x == 0 || x == width - 1);
+
+            switch (d) {
+                case types::Direction::EAST:
+                    if (x + 1 < width)
+                        t = v + 1;
+                    else if (xorientation != types::AxialOrientation::DISCONNECTED)
+                        t = (xflip ? height - 1 - y : y) * width;
+                    else
+                        return false;
+                    e = v;
+                    return true;
+
+                case types::Direction::WEST:
+                    if (x > 0)
+                        t = v - 1;
+                    else if (xorientation != types::AxialOrientation::DISCONNECTED)
+                        t = (xflip ? height - 1 - y : y) * width + width - 1;
+                    else
+                        return false;
+                    e = t;
+                    return true;
+
+                case types::Direction::SOUTH:
+                    if (y + 1 < height)
+                        t = v + width;
+                    else if (yorientation != types::AxialOrientation::DISCONNECTED && !corner)
+                        t = yflip ? width - 1 - x : x;
+                    else
+                        return false;
+                    e = cells + v;
+                    return true;
+
+                case types::Direction::NORTH:
+                    if (y > 0)
+                        t = v - width;
+                    else if (yorientation != types::AxialOrientation::DISCONNECTED && !corner)
+                        t = (height - 1) * width + (yflip ? width - 1 - x : x);
+                    else
+                        return false;
+                    e = cells + t;
+                    return true;
+
+                default:
+                    return false;
+            }
+        }
+    };
+}
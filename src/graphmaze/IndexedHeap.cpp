@@ -0,0 +1,86 @@
+/**
+ * IndexedHeap.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <cstddef>
+
+#include "IndexedHeap.h"
+
+namespace spelunker::graphmaze {
+    IndexedHeap::IndexedHeap(const std::size_t numVertices) {
+        reset(numVertices);
+    }
+
+    void IndexedHeap::reset(const std::size_t numVertices) {
+        entries.clear();
+        positions.assign(numVertices, npos);
+    }
+
+    void IndexedHeap::push(const std::size_t v, const double key) {
+        positions[v] = entries.size();
+        entries.push_back({key, v});
+        siftUp(entries.size() - 1);
+    }
+
+    void IndexedHeap::decreaseKey(const std::size_t v, const double key) noexcept {
+        const auto i = positions[v];
+        entries[i].key = key;
+        siftUp(i);
+    }
+
+    std::size_t IndexedHeap::pop() noexcept {
+        const auto v = entries.front().vertex;
+        positions[v] = npos;
+
+        // Move the last entry to the root and restore the heap below it.
+        const auto last = entries.back();
+        entries.pop_back();
+        if (!entries.empty()) {
+            entries.front() = last;
+            positions[last.vertex] = 0;
+            siftDown(0);
+        }
+        return v;
+    }
+
+    void IndexedHeap::siftUp(std::size_t i) noexcept {
+        const auto entry = entries[i];
+        while (i > 0) {
+            const auto parent = (i - 1) / Arity;
+            if (entries[parent].key <= entry.key)
+                break;
+            entries[i] = entries[parent];
+            positions[entries[i].vertex] = i;
+            i = parent;
+        }
+        entries[i] = entry;
+        positions[entry.vertex] = i;
+    }
+
+    void IndexedHeap::siftDown(std::size_t i) noexcept {
+        const auto n = entries.size();
+        const auto entry = entries[i];
+        while (true) {
+            // Find the child with the least key.
+            const auto first = Arity * i + 1;
+            if (first >= n)
+                break;
+            const auto last = std::min(first + Arity, n);
+            auto least = first;
+            for (auto c = first + 1; c < last; ++c)
+                if (entries[c].key < entries[least].key)
+                    least = c;
+
+            if (entry.key <= entries[least].key)
+                break;
+            entries[i] = entries[least];
+            positions[entries[i].vertex] = i;
+            i = least;
+        }
+        entries[i] = entry;
+        positions[entry.vertex] = i;
+    }
+}
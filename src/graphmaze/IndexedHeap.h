@@ -0,0 +1,78 @@
+/**
+ * IndexedHeap.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace spelunker::graphmaze {
+    /// A min-heap of vertices by key, indexed by vertex so that the key of a vertex in the heap can be decreased.
+    /**
+     * The heap is d-ary with d = Arity, stored as a flat array of (key, vertex) entries, with the position of each
+     * vertex in the array kept in a second array indexed by vertex. A 4-ary heap is half the height of a binary heap,
+     * and the four children of an entry are adjacent in memory, so a sift down compares them within a cache line or
+     * two. Pushing, decreasing a key, and popping take O(log n) time, and checking for or looking up the key of a
+     * vertex takes O(1).
+     */
+    class IndexedHeap final {
+    public:
+        /// The number of children of each entry.
+        static constexpr std::size_t Arity = 4;
+
+        /// The position of a vertex that is not in the heap.
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        IndexedHeap() = default;
+
+        /// Create an empty heap over numVertices vertices.
+        explicit IndexedHeap(std::size_t numVertices);
+
+        /**
+         * Empty the heap, resizing to numVertices.
+         * This is linear in the number of vertices, and reuses the existing storage where possible.
+         */
+        void reset(std::size_t numVertices);
+
+        inline bool empty() const noexcept { return entries.empty(); }
+
+        /// The number of vertices in the heap.
+        inline std::size_t size() const noexcept { return entries.size(); }
+
+        inline bool contains(const std::size_t v) const noexcept { return positions[v] != npos; }
+
+        /// The key of a vertex, which must be in the heap.
+        inline double key(const std::size_t v) const noexcept { return entries[positions[v]].key; }
+
+        /// The vertex with the least key, where the heap is nonempty.
+        inline std::size_t top() const noexcept { return entries.front().vertex; }
+
+        /// Add a vertex, which must not be in the heap, with the given key.
+        void push(std::size_t v, double key);
+
+        /// Lower the key of a vertex, which must be in the heap, to the given key, which must not exceed its key.
+        void decreaseKey(std::size_t v, double key) noexcept;
+
+        /// Remove and return the vertex with the least key, where the heap is nonempty.
+        std::size_t pop() noexcept;
+
+    private:
+        struct Entry {
+            double key;
+            std::size_t vertex;
+        };
+
+        std::vector<Entry> entries;
+        std::vector<std::size_t> positions;
+
+        /// Move the entry at position i up until its parent has a key no greater than its own.
+        void siftUp(std::size_t i) noexcept;
+
+        /// Move the entry at position i down until none of its children have a lesser key than its own.
+        void siftDown(std::size_t i) noexcept;
+    };
+}
@@ -0,0 +1,20 @@
+/**
+ * KruskalMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <math/URBGUtils.h>
+
+#include "GraphUtils.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+#include "KruskalMazeGenerator.h"
+
+namespace spelunker::graphmaze {
+
+    template vertex KruskalMazeGenerator::carveOver(MazeSeed &seed) const;
+    template vertex KruskalMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    template vertex KruskalMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
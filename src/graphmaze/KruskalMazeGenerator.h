@@ -0,0 +1,90 @@
+/**
+ * KruskalMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <math/URBGUtils.h>
+
+#include "DisjointSets.h"
+#include "GraphUtils.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeSeed.h"
+
+namespace spelunker::graphmaze {
+
+    /**
+     * This is a MazeGenerator that works based on randomized Kruskal's algorithm.
+     *
+     * The edges of the template are shuffled once and then considered in order: an edge is carved if its endpoints
+     * lie in different components, which are tracked by the flat union-find of the context. Every edge is touched
+     * once and there is no frontier to maintain, so this is well suited to very large templates. Over a template with
+     * several components, e.g. a mask with islands, it carves a spanning tree of each.
+     *
+     * There is no natural start vertex, so the maze starts at an endpoint of the first passage carved.
+     */
+    class KruskalMazeGenerator final : public GenericMazeGenerator<KruskalMazeGenerator> {
+    public:
+        KruskalMazeGenerator() = default;
+        virtual ~KruskalMazeGenerator() final = default;
+
+    private:
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        friend class GenericMazeGenerator<KruskalMazeGenerator>;
+    };
+
+    template<typename T, typename S, typename R>
+    vertex KruskalMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
+        // Collect every edge once, from its lower endpoint. Self-loops can never be carved, so they are skipped.
+        auto &edges = seed.context.getEdgeBuffer();
+        for (vertex v = 0; v < seed.numVertices; ++v)
+            seed.tmplt.forEachNeighbour(v, [v, &edges](const vertex t, const std::size_t e) {
+                if (v < t)
+                    edges.emplace_back(e);
+            });
+        math::URBGUtils::shuffle(seed.rng, edges);
+
+        auto &sets = seed.context.getDisjointSets();
+        sets.reset(seed.numVertices);
+
+        // A spanning tree has numVertices - 1 edges, so we can stop as soon as we have carved that many.
+        vertex start = 0;
+        std::size_t remaining = seed.numVertices > 0 ? seed.numVertices - 1 : 0;
+        for (auto iter = edges.cbegin(); remaining > 0 && iter != edges.cend(); ++iter) {
+            const auto e = *iter;
+            const auto &ei = seed.tmplt.edgeInfo(e);
+            if (!sets.unite(ei.v1, ei.v2))
+                continue;
+
+            if (remaining == seed.numVertices - 1)
+                start = ei.v1;
+            seed.unvisited.visit(ei.v1);
+            seed.unvisited.visit(ei.v2);
+            GraphUtils::carveEdge(e, seed);
+            --remaining;
+        }
+
+        return start;
+    }
+
+    /// The generator over a MazeTemplate is instantiated once, in KruskalMazeGenerator.cpp.
+    extern template vertex KruskalMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex KruskalMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex KruskalMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
@@ -6,9 +6,18 @@
 
 #pragma once
 
+#include <cstdint>
 #include <tuple>
 
+#include <math/RNGEngine.h>
+
+#include "CarveSink.h"
+#include "CarvedMaze.h"
+#include "GenerationContext.h"
+#include "GraphUtils.h"
 #include "MazeGraph.h"
+#include "MazeSeed.h"
+#include "MazeTemplate.h"
 
 namespace spelunker::graphmaze {
 
@@ -20,12 +29,217 @@ namespace spelunker::graphmaze {
     class MazeGenerator {
     public:
         MazeGenerator() = default;
+        virtual ~MazeGenerator() = default;
 
         /**
          * Generate a maze using the given technique of size width by height.
+         * The template graph is frozen into a MazeTemplate first: to generate several mazes from the same
+         * template, freeze it once and use the MazeTemplate overloads instead.
          * @param tmplt the template graph, as described above
+         * @return the maze generated by the algorithm and its starting vertex
+         */
+        std::pair<MazeGraph, vertex> generate(const MazeGraph &tmplt) const {
+            return generate(MazeTemplate{tmplt});
+        }
+
+        /**
+         * Generate a maze using the given technique over a frozen template.
+         * @param tmplt the frozen template
+         * @return the maze generated by the algorithm and its starting vertex
+         */
+        std::pair<MazeGraph, vertex> generate(const MazeTemplate &tmplt) const {
+            const auto maze = generateCarved(tmplt);
+            return {maze.toGraph(), maze.getStart()};
+        }
+
+        /**
+         * Generate a maze using the given technique over a frozen template into a caller-owned maze.
+         * The maze is rebound to the template and its storage is reused, so generating repeatedly into the same
+         * maze does not reallocate. The template must outlive the maze.
+         * @param tmplt the frozen template
+         * @param maze the maze into which to carve, which also records the starting vertex
+         */
+        void generate(const MazeTemplate &tmplt, CarvedMaze &maze) const {
+            maze.reset(tmplt);
+            GenerationContext context{tmplt};
+            generate(context, maze);
+        }
+
+        /**
+         * Generate a maze using the given technique over the template of a caller-owned maze.
+         * The context supplies all working storage, so generating repeatedly with the same context into the same
+         * maze performs no heap allocation in the steady state.
+         * @param context the generation context, which must be for a template of the same size as that of the maze
+         * @param maze the maze into which to carve, which determines the template and records the starting vertex
+         */
+        void generate(GenerationContext &context, CarvedMaze &maze) const {
+            NullCarveSink sink;
+            math::RNGEngine rng;
+            auto seed = GraphUtils::makeSeed(context, maze, sink, rng);
+            maze.setStart(carve(seed));
+        }
+
+        /**
+         * As generate, but report every passage carved to an observer, e.g. for logging or animation.
+         * @param context the generation context, which must be for a template of the same size as that of the maze
+         * @param maze the maze into which to carve, which determines the template and records the starting vertex
+         * @param observer the observer of the passages carved
+         */
+        void generate(GenerationContext &context, CarvedMaze &maze, CarveObserver &observer) const {
+            math::RNGEngine rng;
+            auto seed = GraphUtils::makeSeed(context, maze, observer, rng);
+            maze.setStart(carve(seed));
+        }
+
+        /**
+         * Generate a maze reproducibly: the random engine of the context is reseeded from the seed and the generator
+         * draws from it alone, so the same seed over the same template always generates the same maze, and
+         * generations with different contexts may run on different threads.
+         * @param context the generation context, which must be for a template of the same size as that of the maze,
+         *                and which supplies the engine
+         * @param maze the maze into which to carve, which determines the template and records the starting vertex
+         * @param seed the seed
+         */
+        void generateFromSeed(GenerationContext &context, CarvedMaze &maze, const std::uint64_t seed) const {
+            NullCarveSink sink;
+            context.reseed(seed);
+            auto seededMaze = GraphUtils::makeSeed(context, maze, sink, context.getEngine());
+            maze.setStart(carve(seededMaze));
+        }
+
+        /**
+         * Generate a maze using the given technique over a frozen template, recording the passages as a
+         * bitvector over the edges of the template. The template must outlive the maze.
+         * @param tmplt the frozen template
+         * @return the maze generated by the algorithm
+         */
+        CarvedMaze generateCarved(const MazeTemplate &tmplt) const {
+            CarvedMaze maze{tmplt};
+            generate(tmplt, maze);
+            return maze;
+        }
+
+    protected:
+        /**
+         * The algorithm itself: carve the passages of a maze into the seed.
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        virtual vertex carve(MazeSeed &seed) const = 0;
+
+        /// As carve, but the seed reports the passages carved to an observer.
+        virtual vertex carve(ObservedMazeSeed &seed) const = 0;
+
+        /// As carve, but the seed draws from the seeded engine of its context.
+        virtual vertex carve(SeededMazeSeed &seed) const = 0;
+    };
+
+    /**
+     * The base of the maze generators whose algorithm can run over any template type.
+     * A template type is anything offering the interface of MazeTemplate used by the generators, namely
+     * numVertices, numEdges, degree, maxDegree, numVertexTypes, forEachNeighbour, forEachNeighbourInDirection,
+     * findEdge, vertexInfo, edgeInfo, and graphInfo: e.g. an ImplicitGridTemplate.
+     *
+     * The Generator must provide a member function template:
+     * template<typename T, typename S, typename R> vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+     * which is called directly, so that the algorithm is compiled against the template, sink, and engine types without
+     * virtual calls in its inner loops. Over a MazeTemplate, it also serves as the virtual carve of the MazeGenerator.
+     * @tparam Generator the derived generator
+     */
+    template<typename Generator>
+    class GenericMazeGenerator : public MazeGenerator {
+    public:
+        using MazeGenerator::generate;
+        using MazeGenerator::generateFromSeed;
+        using MazeGenerator::generateCarved;
+
+        /**
+         * Generate a maze using the given technique over any template into a caller-owned maze.
+         * As for a MazeTemplate, generating repeatedly with the same context into the same maze performs no heap
+         * allocation in the steady state.
+         * @tparam T the template type
+         * @param context the generation context, which must be for a template of the same size as that of the maze
+         * @param maze the maze into which to carve, which determines the template and records the starting vertex
+         * @throws UnsupportedMazeGeneration if the context and the template do not agree in size
+         */
+        template<typename T>
+        void generate(GenerationContext &context, BasicCarvedMaze<T> &maze) const {
+            NullCarveSink sink;
+            generate(context, maze, sink);
+        }
+
+        /**
+         * As generate, but report every passage carved to a sink, whose type is known at compile time.
+         * @tparam T the template type
+         * @tparam S the sink type: see CarveSink.h
+         * @param context the generation context, which must be for a template of the same size as that of the maze
+         * @param maze the maze into which to carve, which determines the template and records the starting vertex
+         * @param sink the sink
+         */
+        template<typename T, typename S>
+        void generate(GenerationContext &context, BasicCarvedMaze<T> &maze, S &sink) const {
+            math::RNGEngine rng;
+            generate(context, maze, sink, rng);
+        }
+
+        /**
+         * As generate, but draw from a random engine supplied by the caller rather than the global RNG.
+         * The engine is a template parameter, so that the draws are inlined into the algorithm.
+         * To draw from an engine without observing the carving, pass a NullCarveSink.
+         * @tparam T the template type
+         * @tparam S the sink type: see CarveSink.h
+         * @tparam R the engine type: any uniform random bit generator, e.g. std::mt19937, or an RNGEngine
+         * @param context the generation context, which must be for a template of the same size as that of the maze
+         * @param maze the maze into which to carve, which determines the template and records the starting vertex
+         * @param sink the sink
+         * @param rng the engine, which is not copied
+         */
+        template<typename T, typename S, typename R>
+        void generate(GenerationContext &context, BasicCarvedMaze<T> &maze, S &sink, R &rng) const {
+            auto seed = GraphUtils::makeSeed(context, maze, sink, rng);
+            maze.setStart(static_cast<const Generator&>(*this).carveOver(seed));
+        }
+
+        /**
+         * Generate a maze reproducibly over any template: see MazeGenerator::generateFromSeed.
+         * @tparam T the template type
+         * @param context the generation context, which must be for a template of the same size as that of the maze
+         * @param maze the maze into which to carve, which determines the template and records the starting vertex
+         * @param seed the seed
+         */
+        template<typename T>
+        void generateFromSeed(GenerationContext &context, BasicCarvedMaze<T> &maze, const std::uint64_t seed) const {
+            NullCarveSink sink;
+            context.reseed(seed);
+            generate(context, maze, sink, context.getEngine());
+        }
+
+        /**
+         * Generate a maze using the given technique over any template, recording the passages as a
+         * bitvector over the edges of the template. The template must outlive the maze.
+         * @tparam T the template type
+         * @param tmplt the template
          * @return the maze generated by the algorithm
          */
-        virtual std::pair<const MazeGraph, const vertex> generate(const MazeGraph &tmplt) const = 0;
+        template<typename T>
+        BasicCarvedMaze<T> generateCarved(const T &tmplt) const {
+            GenerationContext context{tmplt};
+            BasicCarvedMaze<T> maze{tmplt};
+            generate(context, maze);
+            return maze;
+        }
+
+    protected:
+        vertex carve(MazeSeed &seed) const final {
+            return static_cast<const Generator&>(*this).carveOver(seed);
+        }
+
+        vertex carve(ObservedMazeSeed &seed) const final {
+            return static_cast<const Generator&>(*this).carveOver(seed);
+        }
+
+        vertex carve(SeededMazeSeed &seed) const final {
+            return static_cast<const Generator&>(*this).carveOver(seed);
+        }
     };
 }
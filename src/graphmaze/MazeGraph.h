@@ -22,6 +22,9 @@
 #include <types/Direction.h>
 #include <types/Tessellations.h>
 
+#include "GridRanker.h"
+#include "VisitedSet.h"
+
 namespace spelunker::graphmaze {
     /**
      * Forward declarations of MazeGraph to get vertex_descriptor.
@@ -66,9 +69,6 @@ namespace spelunker::graphmaze {
     /// Alias for edges of MazeGraph.
     using edge = MazeGraph::edge_descriptor;
 
-    /// A grid ranker map used to map (x,y) coordinates into vertices.
-    using GridRankerMap = std::map<std::pair<int, int>, vertex>;
-
     /**
      * Vertex properties. A vertex can have a type to indicate its shape or orientation, which is graph-dependent.
      * Examples include some types of omega (graph with non-orthogonal tessellation) graphs, such as:
@@ -105,8 +105,8 @@ namespace spelunker::graphmaze {
 
          std::optional<size_t> width;
          std::optional<size_t> height;
-         types::TessellationType type;
-         std::vector<GridRankerMap> gridRankerMaps;
+         types::TessellationType type = types::TessellationType::GRID;
+         std::vector<GridRanker> gridRankers;
          std::optional<BTCandidateFunction> binaryTreeCandidates;
      };
 
@@ -114,25 +114,7 @@ namespace spelunker::graphmaze {
     using VertexCollection = std::vector<vertex>;
 
     /// A collection of unvisited vertices.
-    using UnvisitedVertices = std::map<vertex, bool>;
-
-    /// Starting point for a maze.
-    /**
-     * These are the starting parameters for maze generation from a graph.
-     * They are as follows:
-     * 1. tmplt: The template from which this maze will be based: represents the cells and their possible connections.
-     * 1. maze: A graph created from the template graph: it is the same as the template graph but with no edges.
-     *    The edges added during maze generation will represent the carved passages and should be a subset
-     *    of edges that appear in the template.
-     * 2. numVertices: The number of vertices (aka cells) in the maze.
-     * 3. unvisited: A vector of length numVertices representing if a vertex has yet to be visited or not.
-     */
-     struct MazeSeed {
-         const MazeGraph &tmplt;
-         MazeGraph maze;
-         const int numVertices;
-         UnvisitedVertices unvisited;
-     };
+    using UnvisitedVertices = VisitedSet;
 
      /// A map of (row, col) to vertex.
      using VertexRank = std::map<std::pair<int, int>, vertex>;
@@ -0,0 +1,56 @@
+/**
+ * MazeSeed.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <math/RNGEngine.h>
+#include <math/SeededEngine.h>
+
+#include "CarveSink.h"
+#include "CarvedMaze.h"
+#include "GenerationContext.h"
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+
+namespace spelunker::graphmaze {
+    /// Starting point for a maze.
+    /**
+     * These are the starting parameters for maze generation from a template of type T, e.g. a MazeTemplate.
+     * They are as follows:
+     * 1. tmplt: The frozen template from which this maze will be based: represents the cells and their possible
+     *    connections.
+     * 2. maze: The maze being carved over the template, which starts with no passages. The passages carved during
+     *    maze generation are recorded as a bitvector over the edges of the template. The maze is owned by the
+     *    caller so that its storage can be reused across generations.
+     * 3. numVertices: The number of vertices (aka cells) in the maze.
+     * 4. unvisited: A bitset of length numVertices representing if a vertex has yet to be visited or not.
+     * 5. context: The workspace that owns unvisited, and which offers preallocated scratch buffers.
+     * 6. sink: The observer of the passages carved, of type S: by default, a NullCarveSink, which costs nothing.
+     * 7. rng: The random engine of type R from which the generator draws: by default, an RNGEngine, which draws
+     *    from the global RNG.
+     */
+    template<typename T, typename S = NullCarveSink, typename R = math::RNGEngine>
+    struct BasicMazeSeed {
+        const T &tmplt;
+        BasicCarvedMaze<T> &maze;
+        const std::size_t numVertices;
+        UnvisitedVertices &unvisited;
+        GenerationContext &context;
+        S &sink;
+        R &rng;
+    };
+
+    /// The seed for a maze over a frozen MazeTemplate.
+    using MazeSeed = BasicMazeSeed<MazeTemplate>;
+
+    /// The seed for a maze over a frozen MazeTemplate, reporting the passages carved to a runtime observer.
+    using ObservedMazeSeed = BasicMazeSeed<MazeTemplate, CarveObserver>;
+
+    /// The seed for a maze over a frozen MazeTemplate, drawing from the seeded engine of its context.
+    using SeededMazeSeed = BasicMazeSeed<MazeTemplate, NullCarveSink, math::SeededEngine>;
+}
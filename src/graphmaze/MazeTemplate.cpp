@@ -0,0 +1,157 @@
+/**
+ * MazeTemplate.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/graph/adjacency_list.hpp>
+
+#include <types/Direction.h>
+#include <types/Exceptions.h>
+
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+
+namespace spelunker::graphmaze {
+    MazeTemplate::MazeTemplate(const MazeGraph &graph)
+        : MazeTemplate{collectVertexInfos(graph), collectEdgeInfos(graph), boost::get_property(graph, GraphInfoPropertyTag())} {}
+
+    MazeTemplate::MazeTemplate(std::vector<VertexInfo> vertexInfos, const std::vector<EdgeInfo> &edgeInfos, GraphInfo graphInfo)
+        : vertexInfos{std::move(vertexInfos)}, info{std::move(graphInfo)} {
+        const auto n = this->vertexInfos.size();
+
+        // Collapse parallel edges, keeping the first occurrence, to mimic the setS out-edges of a MazeGraph.
+        std::vector<std::size_t> order(edgeInfos.size());
+        std::iota(order.begin(), order.end(), 0);
+        const auto key = [&edgeInfos](const std::size_t e) {
+            const auto &ei = edgeInfos[e];
+            return std::make_pair(std::min(ei.v1, ei.v2), std::max(ei.v1, ei.v2));
+        };
+        std::stable_sort(order.begin(), order.end(), [&key](const auto e1, const auto e2) { return key(e1) < key(e2); });
+
+        std::vector<bool> keep(edgeInfos.size(), false);
+        for (std::size_t i = 0; i < order.size(); ++i)
+            keep[order[i]] = i == 0 || key(order[i - 1]) != key(order[i]);
+
+        this->edgeInfos.reserve(edgeInfos.size());
+        for (std::size_t e = 0; e < edgeInfos.size(); ++e)
+            if (keep[e])
+                this->edgeInfos.emplace_back(edgeInfos[e]);
+
+        // Count the degrees and lay out the offsets. A loop only occupies one slot.
+        offsets.assign(n + 1, 0);
+        for (const auto &ei: this->edgeInfos) {
+            ++offsets[ei.v1 + 1];
+            if (ei.v1 != ei.v2)
+                ++offsets[ei.v2 + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        // Fill in the slots.
+        targets.resize(offsets.back());
+        slotEdges.resize(offsets.back());
+        std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+        for (std::size_t e = 0; e < this->edgeInfos.size(); ++e) {
+            const auto &ei = this->edgeInfos[e];
+            targets[next[ei.v1]] = ei.v2;
+            slotEdges[next[ei.v1]++] = e;
+            if (ei.v1 != ei.v2) {
+                targets[next[ei.v2]] = ei.v1;
+                slotEdges[next[ei.v2]++] = e;
+            }
+        }
+
+        // Sort the slots of each vertex by target.
+        std::vector<std::pair<vertex, std::size_t>> scratch;
+        for (vertex v = 0; v < n; ++v) {
+            scratch.clear();
+            for (auto s = offsets[v]; s < offsets[v + 1]; ++s)
+                scratch.emplace_back(targets[s], slotEdges[s]);
+            std::sort(scratch.begin(), scratch.end());
+            for (auto s = offsets[v]; s < offsets[v + 1]; ++s)
+                std::tie(targets[s], slotEdges[s]) = scratch[s - offsets[v]];
+        }
+
+        // Record the maximum degree and the number of vertex types, which size the scratch storage of generators.
+        maxDeg = 0;
+        for (vertex v = 0; v < n; ++v)
+            maxDeg = std::max(maxDeg, degree(v));
+        numTypes = 0;
+        for (const auto &vi: this->vertexInfos)
+            if (vi.type >= 0)
+                numTypes = std::max(numTypes, static_cast<std::size_t>(vi.type) + 1);
+
+        buildDirectionSlots();
+    }
+
+    std::optional<std::size_t> MazeTemplate::findEdge(const vertex v1, const vertex v2) const noexcept {
+        for (auto s = offsets[v1]; s < offsets[v1 + 1]; ++s)
+            if (targets[s] == v2)
+                return slotEdges[s];
+        return std::nullopt;
+    }
+
+    void MazeTemplate::buildDirectionSlots() {
+        // The table stores slots in 31 bits, with the top bit flagging multiple slots in one direction.
+        if (targets.size() >= MultipleEntry)
+            throw types::UnsupportedTemplateGeneration{};
+
+        // Assign a column to each direction that appears in the template.
+        directionColumns.fill(NoColumn);
+        numDirectionColumns = 0;
+        for (const auto &ei: edgeInfos)
+            for (const auto d: {ei.d1, ei.d2})
+                if (directionColumns[types::dirIdx(d)] == NoColumn)
+                    directionColumns[types::dirIdx(d)] = static_cast<std::uint8_t>(numDirectionColumns++);
+
+        // Record the first slot of each vertex in each direction, flagging those with more than one.
+        // A loop has both of its directions at the same slot.
+        directionSlots.assign(numVertices() * numDirectionColumns, NoEntry);
+        for (vertex v = 0; v < numVertices(); ++v) {
+            for (auto s = offsets[v]; s < offsets[v + 1]; ++s) {
+                const auto &ei = edgeInfos[slotEdges[s]];
+                const auto record = [this, v, s](const types::Direction d) {
+                    auto &entry = directionSlots[v * numDirectionColumns + directionColumns[types::dirIdx(d)]];
+                    if (entry == NoEntry)
+                        entry = static_cast<std::uint32_t>(s);
+                    else if ((entry & ~MultipleEntry) != s)
+                        entry |= MultipleEntry;
+                };
+                if (ei.v1 == v)
+                    record(ei.d1);
+                if (ei.v2 == v)
+                    record(ei.d2);
+            }
+        }
+    }
+
+    MazeGraph MazeTemplate::toGraph() const {
+        MazeGraph g;
+        for (const auto &vi: vertexInfos)
+            boost::add_vertex(vi, g);
+        for (const auto &ei: edgeInfos)
+            boost::add_edge(ei.v1, ei.v2, ei, g);
+        boost::set_property(g, GraphInfoPropertyTag(), info);
+        return g;
+    }
+
+    std::vector<VertexInfo> MazeTemplate::collectVertexInfos(const MazeGraph &graph) {
+        std::vector<VertexInfo> vertexInfos;
+        for (auto [vIter, vEnd] = boost::vertices(graph); vIter != vEnd; ++vIter)
+            vertexInfos.emplace_back(boost::get(VertexInfoPropertyTag(), graph, *vIter));
+        return vertexInfos;
+    }
+
+    std::vector<EdgeInfo> MazeTemplate::collectEdgeInfos(const MazeGraph &graph) {
+        std::vector<EdgeInfo> edgeInfos;
+        for (auto [eIter, eEnd] = boost::edges(graph); eIter != eEnd; ++eIter)
+            edgeInfos.emplace_back(boost::get(EdgeInfoPropertyTag(), graph, *eIter));
+        return edgeInfos;
+    }
+}
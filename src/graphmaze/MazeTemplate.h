@@ -0,0 +1,204 @@
+/**
+ * MazeTemplate.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A frozen, immutable compressed-sparse-row (CSR) representation of a maze template.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <types/Direction.h>
+
+#include "MazeGraph.h"
+
+namespace spelunker::graphmaze {
+    /// An immutable compressed-sparse-row maze template.
+    /**
+     * A MazeGraph uses a set for the out-edges of every vertex, which makes every neighbour walk a tree traversal.
+     * Once a template has been built, however, it never changes, so we freeze it into three contiguous arrays:
+     * 1. offsets: for a vertex v, its slots are the half-open range [offsets[v], offsets[v+1]);
+     * 2. targets: for a slot s, the neighbour reached through it; and
+     * 3. slotEdges: for a slot s, the index of the (undirected) edge it represents.
+     *
+     * Edges are numbered 0 to numEdges() - 1, and their properties are stored in a parallel array indexed by
+     * edge index. Each undirected edge occupies two slots, one per endpoint. Within a vertex, the slots are sorted
+     * by target, which is the same order in which a MazeGraph (with setS out-edges) lists them.
+     *
+     * For algorithms driven by direction, we also precompute a direction slot table, which for each vertex and
+     * each direction used by the template gives the slot of the edge in that direction, so that finding the
+     * neighbour in direction d is an array load instead of a scan of the out-edges. A few templates have several
+     * edges from a vertex in the same direction (e.g. the poles of a sphere): the table then gives the first, and
+     * forEachSlotInDirection visits all of them.
+     */
+    class MazeTemplate final {
+    public:
+        /// Returned by the direction slot table if there is no edge in a direction.
+        static constexpr std::size_t NoSlot = std::numeric_limits<std::size_t>::max();
+
+        /// Freeze a MazeGraph into a template.
+        explicit MazeTemplate(const MazeGraph &graph);
+
+        /**
+         * Build a template directly from its vertices and edges.
+         * As with a MazeGraph, parallel edges are collapsed: only the first occurrence is kept.
+         * @param vertexInfos the properties of the vertices, indexed by vertex
+         * @param edgeInfos the edges, with endpoints given by v1 and v2
+         * @param graphInfo the graph properties
+         */
+        MazeTemplate(std::vector<VertexInfo> vertexInfos, const std::vector<EdgeInfo> &edgeInfos, GraphInfo graphInfo);
+
+        MazeTemplate(const MazeTemplate&) = default;
+        MazeTemplate(MazeTemplate&&) = default;
+        ~MazeTemplate() = default;
+
+        inline std::size_t numVertices() const noexcept { return vertexInfos.size(); }
+        inline std::size_t numEdges() const noexcept { return edgeInfos.size(); }
+        inline std::size_t degree(const vertex v) const noexcept { return offsets[v + 1] - offsets[v]; }
+
+        /// The maximum degree of any vertex.
+        inline std::size_t maxDegree() const noexcept { return maxDeg; }
+
+        /// One more than the largest vertex type, i.e. the number of vertex types if they are numbered from 0.
+        inline std::size_t numVertexTypes() const noexcept { return numTypes; }
+
+        /// The first slot of v.
+        inline std::size_t firstSlot(const vertex v) const noexcept { return offsets[v]; }
+
+        /// One past the last slot of v.
+        inline std::size_t lastSlot(const vertex v) const noexcept { return offsets[v + 1]; }
+
+        /// The neighbour reached through a slot.
+        inline vertex slotTarget(const std::size_t slot) const noexcept { return targets[slot]; }
+
+        /// The edge index represented by a slot.
+        inline std::size_t slotEdge(const std::size_t slot) const noexcept { return slotEdges[slot]; }
+
+        /**
+         * Visit every neighbour of v, in slot order.
+         * @tparam F a callable taking (vertex target, std::size_t edgeIndex)
+         * @param v the vertex
+         * @param f the callable
+         */
+        template<typename F>
+        inline void forEachNeighbour(const vertex v, F &&f) const {
+            for (auto s = offsets[v]; s < offsets[v + 1]; ++s)
+                f(targets[s], slotEdges[s]);
+        }
+
+        /**
+         * Find the slot of the edge from v in direction d.
+         * @param v the vertex
+         * @param d the direction
+         * @return the slot, or NoSlot if there is no edge from v in direction d
+         */
+        inline std::size_t directionSlot(const vertex v, const types::Direction d) const noexcept {
+            const auto column = directionColumns[types::dirIdx(d)];
+            if (column == NoColumn)
+                return NoSlot;
+            const auto entry = directionSlots[v * numDirectionColumns + column];
+            return entry == NoEntry ? NoSlot : (entry & ~MultipleEntry);
+        }
+
+        /**
+         * Visit every slot of v in direction d. This is usually at most one slot, found by a table lookup.
+         * @tparam F a callable taking (std::size_t slot)
+         * @param v the vertex
+         * @param d the direction
+         * @param f the callable
+         */
+        template<typename F>
+        inline void forEachSlotInDirection(const vertex v, const types::Direction d, F &&f) const {
+            const auto column = directionColumns[types::dirIdx(d)];
+            if (column == NoColumn)
+                return;
+            const auto entry = directionSlots[v * numDirectionColumns + column];
+            if (entry == NoEntry)
+                return;
+            if (!(entry & MultipleEntry)) {
+                f(static_cast<std::size_t>(entry));
+                return;
+            }
+            for (auto s = offsets[v]; s < offsets[v + 1]; ++s)
+                if (slotDirection(v, s) == d)
+                    f(s);
+        }
+
+        /**
+         * Visit every neighbour of v in direction d.
+         * @tparam F a callable taking (vertex target, std::size_t edgeIndex)
+         * @param v the vertex
+         * @param d the direction
+         * @param f the callable
+         */
+        template<typename F>
+        inline void forEachNeighbourInDirection(const vertex v, const types::Direction d, F &&f) const {
+            forEachSlotInDirection(v, d, [this, &f](const std::size_t slot) {
+                f(targets[slot], slotEdges[slot]);
+            });
+        }
+
+        /// The direction of a slot of v, as seen from v.
+        inline types::Direction slotDirection(const vertex v, const std::size_t slot) const noexcept {
+            const auto &ei = edgeInfos[slotEdges[slot]];
+            return ei.v1 == v ? ei.d1 : ei.d2;
+        }
+
+        /**
+         * Find the index of the edge between two vertices, if there is one.
+         * This is linear in the degree of v1.
+         */
+        std::optional<std::size_t> findEdge(vertex v1, vertex v2) const noexcept;
+
+        inline const VertexInfo &vertexInfo(const vertex v) const noexcept { return vertexInfos[v]; }
+        inline const EdgeInfo &edgeInfo(const std::size_t e) const noexcept { return edgeInfos[e]; }
+        inline const GraphInfo &graphInfo() const noexcept { return info; }
+
+        /// Thaw the template back into a MazeGraph.
+        MazeGraph toGraph() const;
+
+    private:
+        std::vector<std::size_t> offsets;
+        std::vector<vertex> targets;
+        std::vector<std::size_t> slotEdges;
+
+        std::vector<VertexInfo> vertexInfos;
+        std::vector<EdgeInfo> edgeInfos;
+        GraphInfo info;
+
+        std::size_t maxDeg;
+        std::size_t numTypes;
+
+        /// Marks a direction that is not used anywhere in the template.
+        static constexpr std::uint8_t NoColumn = std::numeric_limits<std::uint8_t>::max();
+
+        /// Marks a vertex that has no edge in a direction.
+        static constexpr std::uint32_t NoEntry = std::numeric_limits<std::uint32_t>::max();
+
+        /// Flags an entry as the first of several slots of a vertex in the same direction.
+        static constexpr std::uint32_t MultipleEntry = std::uint32_t{1} << 31;
+
+        /// The column of each direction in the direction slot table, or NoColumn if it is not used.
+        std::array<std::uint8_t, types::NumDirections> directionColumns;
+        std::size_t numDirectionColumns;
+
+        /// The direction slot table, with numDirectionColumns entries per vertex.
+        std::vector<std::uint32_t> directionSlots;
+
+        /// Build the direction slot table from the slots.
+        void buildDirectionSlots();
+
+        /// Collect the vertices of a MazeGraph.
+        static std::vector<VertexInfo> collectVertexInfos(const MazeGraph &graph);
+
+        /// Collect the edges of a MazeGraph.
+        static std::vector<EdgeInfo> collectEdgeInfos(const MazeGraph &graph);
+    };
+}
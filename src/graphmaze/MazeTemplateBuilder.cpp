@@ -0,0 +1,42 @@
+/**
+ * MazeTemplateBuilder.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <utility>
+
+#include <boost/graph/adjacency_list.hpp>
+
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+#include "MazeTemplateBuilder.h"
+
+namespace spelunker::graphmaze {
+    vertex MazeTemplateBuilder::addVertex(const VertexInfo vi) {
+        vertexInfos.emplace_back(vi);
+        return vertexInfos.size() - 1;
+    }
+
+    void MazeTemplateBuilder::addEdge(const EdgeInfo &ei) {
+        edgeInfos.emplace_back(ei);
+    }
+
+    void MazeTemplateBuilder::setGraphInfo(GraphInfo gi) {
+        info = std::move(gi);
+    }
+
+    MazeGraph MazeTemplateBuilder::toGraph() const {
+        MazeGraph g;
+        for (const auto &vi: vertexInfos)
+            boost::add_vertex(vi, g);
+        for (const auto &ei: edgeInfos)
+            boost::add_edge(ei.v1, ei.v2, ei, g);
+        boost::set_property(g, GraphInfoPropertyTag(), info);
+        return g;
+    }
+
+    MazeTemplate MazeTemplateBuilder::toTemplate() const {
+        return MazeTemplate{vertexInfos, edgeInfos, info};
+    }
+}
@@ -0,0 +1,54 @@
+/**
+ * MazeTemplateBuilder.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Collects the vertices and edges of a template so that it can be emitted either as a MazeGraph or as a
+ * frozen MazeTemplate.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+
+namespace spelunker::graphmaze {
+    /**
+     * The template generation functions in GraphUtils describe their templates to a builder, which can then
+     * emit a MazeGraph, or a MazeTemplate without ever materializing the MazeGraph.
+     */
+    class MazeTemplateBuilder final {
+    public:
+        MazeTemplateBuilder() = default;
+        ~MazeTemplateBuilder() = default;
+
+        /**
+         * Add a vertex.
+         * @param vi the properties of the vertex
+         * @return the new vertex
+         */
+        vertex addVertex(VertexInfo vi = VertexInfo{0});
+
+        /**
+         * Add an edge between ei.v1 and ei.v2. As with a MazeGraph, only the first of any parallel edges is kept.
+         * @param ei the properties of the edge
+         */
+        void addEdge(const EdgeInfo &ei);
+
+        /// Set the graph properties.
+        void setGraphInfo(GraphInfo gi);
+
+        /// Emit the described template as a MazeGraph.
+        MazeGraph toGraph() const;
+
+        /// Emit the described template as a MazeTemplate.
+        MazeTemplate toTemplate() const;
+
+    private:
+        std::vector<VertexInfo> vertexInfos;
+        std::vector<EdgeInfo> edgeInfos;
+        GraphInfo info;
+    };
+}
@@ -0,0 +1,145 @@
+/**
+ * MazeTemplateGraph.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Adapt a MazeTemplate to the Boost Graph Library concepts so that BGL algorithms and adaptors
+ * (in particular, filtered_graph) can run directly over a frozen template.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <tuple>
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+#include <boost/property_map/property_map.hpp>
+
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+
+namespace spelunker::graphmaze {
+    /**
+     * An edge of a MazeTemplate as seen by the BGL.
+     * Edges are identified by their index in the template, but as the template is undirected, an out-edge of v must
+     * report v as its source, so we carry the endpoints in the orientation from which the edge was reached.
+     */
+    struct TemplateEdge {
+        vertex src;
+        vertex tgt;
+        std::size_t index;
+
+        bool operator==(const TemplateEdge &other) const noexcept { return index == other.index; }
+        bool operator!=(const TemplateEdge &other) const noexcept { return index != other.index; }
+    };
+
+    /// Map a slot of a vertex to the out-edge it represents.
+    struct TemplateSlotToEdge {
+        const MazeTemplate *tmplt = nullptr;
+        vertex v = 0;
+
+        TemplateEdge operator()(const std::size_t slot) const noexcept {
+            return TemplateEdge{v, tmplt->slotTarget(slot), tmplt->slotEdge(slot)};
+        }
+    };
+
+    /// Map an edge index to the edge it represents.
+    struct TemplateIndexToEdge {
+        const MazeTemplate *tmplt = nullptr;
+
+        TemplateEdge operator()(const std::size_t e) const noexcept {
+            const auto &ei = tmplt->edgeInfo(e);
+            return TemplateEdge{ei.v1, ei.v2, e};
+        }
+    };
+}
+
+namespace boost {
+    template<>
+    struct graph_traits<spelunker::graphmaze::MazeTemplate> {
+    private:
+        struct traversal_tag :
+                public virtual incidence_graph_tag,
+                public virtual vertex_list_graph_tag,
+                public virtual edge_list_graph_tag {};
+
+    public:
+        using vertex_descriptor = spelunker::graphmaze::vertex;
+        using edge_descriptor = spelunker::graphmaze::TemplateEdge;
+        using directed_category = undirected_tag;
+        using edge_parallel_category = disallow_parallel_edge_tag;
+        using traversal_category = traversal_tag;
+
+        using vertex_iterator = counting_iterator<vertex_descriptor>;
+        using out_edge_iterator = transform_iterator<spelunker::graphmaze::TemplateSlotToEdge,
+                counting_iterator<std::size_t>, edge_descriptor, edge_descriptor>;
+        using in_edge_iterator = out_edge_iterator;
+        using edge_iterator = transform_iterator<spelunker::graphmaze::TemplateIndexToEdge,
+                counting_iterator<std::size_t>, edge_descriptor, edge_descriptor>;
+
+        using vertices_size_type = std::size_t;
+        using edges_size_type = std::size_t;
+        using degree_size_type = std::size_t;
+
+        static vertex_descriptor null_vertex() noexcept { return std::numeric_limits<vertex_descriptor>::max(); }
+    };
+
+    template<>
+    struct property_map<spelunker::graphmaze::MazeTemplate, vertex_index_t> {
+        using type = typed_identity_property_map<std::size_t>;
+        using const_type = type;
+    };
+}
+
+namespace spelunker::graphmaze {
+    /// The BGL traits of a MazeTemplate.
+    using TemplateTraits = boost::graph_traits<MazeTemplate>;
+
+    inline std::pair<TemplateTraits::vertex_iterator, TemplateTraits::vertex_iterator>
+    vertices(const MazeTemplate &g) noexcept {
+        return {TemplateTraits::vertex_iterator{0}, TemplateTraits::vertex_iterator{g.numVertices()}};
+    }
+
+    inline std::size_t num_vertices(const MazeTemplate &g) noexcept {
+        return g.numVertices();
+    }
+
+    inline std::pair<TemplateTraits::out_edge_iterator, TemplateTraits::out_edge_iterator>
+    out_edges(const vertex v, const MazeTemplate &g) noexcept {
+        const TemplateSlotToEdge f{&g, v};
+        return {TemplateTraits::out_edge_iterator{boost::counting_iterator<std::size_t>{g.firstSlot(v)}, f},
+                TemplateTraits::out_edge_iterator{boost::counting_iterator<std::size_t>{g.lastSlot(v)}, f}};
+    }
+
+    inline std::size_t out_degree(const vertex v, const MazeTemplate &g) noexcept {
+        return g.degree(v);
+    }
+
+    inline vertex source(const TemplateEdge &e, const MazeTemplate&) noexcept {
+        return e.src;
+    }
+
+    inline vertex target(const TemplateEdge &e, const MazeTemplate&) noexcept {
+        return e.tgt;
+    }
+
+    inline std::pair<TemplateTraits::edge_iterator, TemplateTraits::edge_iterator>
+    edges(const MazeTemplate &g) noexcept {
+        const TemplateIndexToEdge f{&g};
+        return {TemplateTraits::edge_iterator{boost::counting_iterator<std::size_t>{0}, f},
+                TemplateTraits::edge_iterator{boost::counting_iterator<std::size_t>{g.numEdges()}, f}};
+    }
+
+    inline std::size_t num_edges(const MazeTemplate &g) noexcept {
+        return g.numEdges();
+    }
+
+    /// Vertices of a template are already indices.
+    inline boost::typed_identity_property_map<std::size_t> get(boost::vertex_index_t, const MazeTemplate&) noexcept {
+        return {};
+    }
+}
@@ -0,0 +1,28 @@
+/**
+ * ParallelBFSMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "GraphUtils.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+#include "ParallelBFSMazeGenerator.h"
+#include "ThreadPool.h"
+
+namespace spelunker::graphmaze {
+    ParallelBFSMazeGenerator::ParallelBFSMazeGenerator(const std::size_t numThreads)
+        : pool{std::make_shared<ThreadPool>(numThreads)} {}
+
+    ParallelBFSMazeGenerator::ParallelBFSMazeGenerator(std::shared_ptr<ThreadPool> pool) noexcept
+        : pool{std::move(pool)} {}
+
+    template vertex ParallelBFSMazeGenerator::carveOver(MazeSeed &seed) const;
+    template vertex ParallelBFSMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    template vertex ParallelBFSMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
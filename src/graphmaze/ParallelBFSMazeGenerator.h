@@ -0,0 +1,170 @@
+/**
+ * ParallelBFSMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <math/PhiloxEngine.h>
+#include <math/URBGUtils.h>
+
+#include "ClaimSet.h"
+#include "GraphUtils.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeSeed.h"
+#include "ThreadPool.h"
+
+namespace spelunker::graphmaze {
+
+    /**
+     * This is a MazeGenerator that works based on a breadth first search, run level by level across a pool of
+     * threads.
+     *
+     * BFSMazeGenerator enqueues a vertex once per visited neighbour, and skips the copies when it dequeues them.
+     * Here, each level of the search is expanded in parallel, and a vertex joins the next level only through the
+     * thread that claims it first in the ClaimSet of the GenerationContext, so every vertex is queued exactly once.
+     * Each vertex of the next level is then joined by a passage to a random neighbour in the level before it.
+     *
+     * The random neighbour is drawn from a PhiloxEngine stream of its own, keyed by a salt drawn from the engine and
+     * indexed by the vertex, so that the threads share no engine, and the maze is the same for any number of
+     * threads. Only the order of the vertices within a level, and so the order in which their passages are reported
+     * to a sink, depends on how the threads race for the claims.
+     */
+    class ParallelBFSMazeGenerator final : public GenericMazeGenerator<ParallelBFSMazeGenerator> {
+    public:
+        /// The smallest number of vertices of a level worth handing to a thread.
+        static constexpr std::size_t Grain = std::size_t{1} << 12;
+
+        /**
+         * Create a generator with a pool of its own.
+         * @param numThreads the number of threads, or 0 for the number of hardware threads
+         */
+        explicit ParallelBFSMazeGenerator(std::size_t numThreads = 0);
+
+        /// Create a generator that runs on a pool, which may be shared with other generators.
+        explicit ParallelBFSMazeGenerator(std::shared_ptr<ThreadPool> pool) noexcept;
+
+        virtual ~ParallelBFSMazeGenerator() final = default;
+
+        inline const std::shared_ptr<ThreadPool> &getPool() const noexcept { return pool; }
+
+    private:
+        std::shared_ptr<ThreadPool> pool;
+
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        friend class GenericMazeGenerator<ParallelBFSMazeGenerator>;
+    };
+
+    template<typename T, typename S, typename R>
+    vertex ParallelBFSMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
+        const auto &tmplt = seed.tmplt;
+        const auto &unvisited = seed.unvisited;
+        auto &claims = seed.context.getClaimSet();
+        claims.reset(seed.numVertices);
+
+        // The levels are laid out one after another in the vertex buffer, and the passage joining each vertex to
+        // the level before it is recorded at the same position in the edge buffer.
+        auto &cells = seed.context.getVertexBuffer();
+        auto &passages = seed.context.getEdgeBuffer();
+        cells.resize(seed.numVertices);
+        passages.resize(seed.numVertices);
+
+        std::uint32_t words[2];
+        math::URBGUtils::fillWords(seed.rng, words, 2);
+        const auto salt = (static_cast<std::uint64_t>(words[0]) << 32) | words[1];
+
+        const auto start = GraphUtils::randomStartVertex(seed.rng, tmplt);
+        claims.tryClaim(start);
+        seed.unvisited.visit(start);
+        cells[0] = start;
+
+        // The vertices claimed by each range of a level, and their offsets in the next level.
+        auto &claimed = seed.context.getRangeBuffers();
+        auto &offsets = seed.context.getOffsetBuffer();
+
+        std::size_t begin = 0;
+        std::size_t end = 1;
+        while (begin < end) {
+            // Claim the unclaimed neighbours of the level.
+            const auto n = end - begin;
+            const auto ranges = pool->numRanges(n, Grain);
+            if (claimed.size() < ranges)
+                claimed.resize(ranges);
+            offsets.assign(ranges + 1, 0);
+            const auto claim = [&tmplt, &claims, &cells, &claimed, &offsets, begin, n, ranges](const std::size_t r) {
+                auto &out = claimed[r];
+                out.clear();
+                for (auto i = begin + r * n / ranges; i < begin + (r + 1) * n / ranges; ++i)
+                    tmplt.forEachNeighbour(cells[i], [&claims, &out](const vertex t, std::size_t) {
+                        if (!claims.isClaimed(t) && claims.tryClaim(t))
+                            out.emplace_back(t);
+                    });
+                offsets[r + 1] = out.size();
+            };
+            pool->parallelFor(ranges, claim);
+            for (std::size_t r = 0; r < ranges; ++r)
+                offsets[r + 1] += offsets[r];
+            const auto next = end + offsets[ranges];
+
+            // Gather the claimed vertices into the next level.
+            pool->parallelFor(ranges, [&cells, &claimed, &offsets, end](const std::size_t r) {
+                std::copy(claimed[r].cbegin(), claimed[r].cend(), cells.begin() + end + offsets[r]);
+            });
+
+            // Join each vertex of the next level to a random neighbour in this level, i.e. a visited neighbour.
+            pool->parallelRanges(next - end, Grain,
+                                 [&tmplt, &unvisited, &cells, &passages, end, salt](const std::size_t b,
+                                                                                      const std::size_t e) {
+                for (auto i = end + b; i < end + e; ++i) {
+                    const auto u = cells[i];
+                    std::uint64_t count = 0;
+                    tmplt.forEachNeighbour(u, [&unvisited, &count](const vertex t, std::size_t) {
+                        count += unvisited.isVisited(t);
+                    });
+
+                    math::PhiloxEngine stream{salt, u};
+                    auto k = stream.randomBelow(count);
+                    tmplt.forEachNeighbour(u, [&unvisited, &passages, &k, i](const vertex t, const std::size_t edge) {
+                        if (unvisited.isVisited(t) && k-- == 0)
+                            passages[i] = edge;
+                    });
+                }
+            });
+
+            // Visit the next level and carve its passages.
+            for (auto i = end; i < next; ++i) {
+                seed.unvisited.visit(cells[i]);
+                GraphUtils::carveEdge(passages[i], seed);
+            }
+
+            begin = end;
+            end = next;
+        }
+
+        return start;
+    }
+
+    /// The generator over a MazeTemplate is instantiated once, in ParallelBFSMazeGenerator.cpp.
+    extern template vertex ParallelBFSMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex ParallelBFSMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex ParallelBFSMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
@@ -0,0 +1,28 @@
+/**
+ * ParallelBinaryTreeMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "GraphUtils.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+#include "ParallelBinaryTreeMazeGenerator.h"
+#include "ThreadPool.h"
+
+namespace spelunker::graphmaze {
+    ParallelBinaryTreeMazeGenerator::ParallelBinaryTreeMazeGenerator(const std::size_t numThreads)
+        : pool{std::make_shared<ThreadPool>(numThreads)} {}
+
+    ParallelBinaryTreeMazeGenerator::ParallelBinaryTreeMazeGenerator(std::shared_ptr<ThreadPool> pool) noexcept
+        : pool{std::move(pool)} {}
+
+    template vertex ParallelBinaryTreeMazeGenerator::carveOver(MazeSeed &seed) const;
+    template vertex ParallelBinaryTreeMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    template vertex ParallelBinaryTreeMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
@@ -0,0 +1,209 @@
+/**
+ * ParallelBinaryTreeMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <math/DrawBuffer.h>
+#include <math/PhiloxEngine.h>
+#include <math/URBGUtils.h>
+#include <types/Exceptions.h>
+
+#include "GraphUtils.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeSeed.h"
+#include "ThreadPool.h"
+
+namespace spelunker::graphmaze {
+
+    /**
+     * This is a MazeGenerator that works based on the binary tree algorithm (see BinaryTreeMazeGenerator), with the
+     * vertices split into chunks that are carved across a pool of threads.
+     *
+     * The binary tree algorithm carves, from each vertex v in turn, a passage in a candidate direction to a vertex
+     * that is still unvisited, and v is visited if it carved. A target after v is always unvisited, and v itself
+     * (across a loop of one vertex) is too, so only a target before v, which arises where an axis wraps around,
+     * ties v to the vertices before it. The chunks pick the passages of all of the other vertices independently,
+     * and defer these few, which are then carved in order once every vertex before them has been settled.
+     *
+     * Each chunk draws from a PhiloxEngine stream of its own, keyed by a salt drawn from the engine and indexed by
+     * the chunk, and the deferred vertices draw from the engine. As the chunks are of a fixed size, the maze is the
+     * same for any number of threads. The passages are recorded per vertex and carved in vertex order after each
+     * round of chunks, so they are reported to a sink in the same order as by BinaryTreeMazeGenerator, and the
+     * memory used is bounded however large the template.
+     *
+     * The maze has the same shape as one made by BinaryTreeMazeGenerator, but not the same passages, as the draws
+     * differ.
+     */
+    class ParallelBinaryTreeMazeGenerator final : public GenericMazeGenerator<ParallelBinaryTreeMazeGenerator> {
+    public:
+        /// The number of vertices in a chunk, which draws from one stream.
+        static constexpr std::size_t Grain = std::size_t{1} << 12;
+
+        /// The number of chunks whose passages are recorded before they are carved.
+        static constexpr std::size_t ChunksPerRound = 64;
+
+        /**
+         * Create a generator with a pool of its own.
+         * @param numThreads the number of threads, or 0 for the number of hardware threads
+         */
+        explicit ParallelBinaryTreeMazeGenerator(std::size_t numThreads = 0);
+
+        /// Create a generator that runs on a pool, which may be shared with other generators.
+        explicit ParallelBinaryTreeMazeGenerator(std::shared_ptr<ThreadPool> pool) noexcept;
+
+        virtual ~ParallelBinaryTreeMazeGenerator() final = default;
+
+        inline const std::shared_ptr<ThreadPool> &getPool() const noexcept { return pool; }
+
+    private:
+        /// The number of targets of a vertex that a chunk keeps at hand: the rest are found again if they are drawn.
+        static constexpr std::size_t MaxTargets = 8;
+
+        /// The passage recorded for a vertex that does not carve.
+        static constexpr std::size_t NoPassage = std::numeric_limits<std::size_t>::max();
+
+        std::shared_ptr<ThreadPool> pool;
+
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        friend class GenericMazeGenerator<ParallelBinaryTreeMazeGenerator>;
+    };
+
+    template<typename T, typename S, typename R>
+    vertex ParallelBinaryTreeMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
+        const auto &tmplt = seed.tmplt;
+
+        // Make sure that we have a binary tree function, which is needed to pick carving directions.
+        // The context has already evaluated it for each vertex type.
+        if (!tmplt.graphInfo().binaryTreeCandidates.has_value())
+            throw types::UnsupportedMazeGeneration();
+
+        const auto &context = seed.context;
+        const auto n = seed.numVertices;
+
+        // Visit the targets of v in its candidate directions.
+        const auto forEachTarget = [&tmplt, &context](const vertex v, auto &&f) {
+            for (const auto dir: context.getCandidateDirections(tmplt.vertexInfo(v).type))
+                tmplt.forEachNeighbourInDirection(v, dir, f);
+        };
+
+        std::uint32_t words[2];
+        math::URBGUtils::fillWords(seed.rng, words, 2);
+        const auto salt = (static_cast<std::uint64_t>(words[0]) << 32) | words[1];
+
+        // A vertex with no target before it carves if it has a target at all. A vertex with a target before it is
+        // deferred, and is visited once it has carved.
+        const auto carved = [&forEachTarget, &seed](const vertex t) {
+            bool before = false;
+            bool after = false;
+            forEachTarget(t, [&before, &after, t](const vertex u, std::size_t) { (u >= t ? after : before) = true; });
+            return before ? seed.unvisited.isVisited(t) : after;
+        };
+
+        // The deferred vertices are carved in order, drawing from the engine.
+        math::DrawBuffer<R> draws{seed.rng};
+        auto &candidates = seed.context.getNeighbourBuffer();
+
+        // The passage carved from each vertex of a round, or NoPassage, and the deferred vertices of each chunk.
+        const auto roundSize = Grain * ChunksPerRound;
+        auto &passages = seed.context.getEdgeBuffer();
+        passages.resize(std::min(n, roundSize));
+        auto &deferred = seed.context.getRangeBuffers();
+        if (deferred.size() < ChunksPerRound)
+            deferred.resize(ChunksPerRound);
+
+        for (std::size_t begin = 0; begin < n; begin += roundSize) {
+            const auto end = std::min(n, begin + roundSize);
+            const auto chunks = (end - begin + Grain - 1) / Grain;
+
+            // Pick the passages of each chunk of the round, deferring the vertices with targets before them.
+            const auto pick = [&forEachTarget, &passages, &deferred, begin, end, salt](const std::size_t c) {
+                const auto b = begin + c * Grain;
+                const auto e = std::min(end, b + Grain);
+                math::PhiloxEngine stream{salt, b / Grain};
+                std::size_t edges[MaxTargets];
+                deferred[c].clear();
+                for (auto v = b; v < e; ++v) {
+                    auto &passage = passages[v - begin];
+                    passage = NoPassage;
+
+                    bool defer = false;
+                    std::size_t count = 0;
+                    forEachTarget(v, [&defer, &edges, &count, v](const vertex t, const std::size_t edge) {
+                        if (t < v)
+                            defer = true;
+                        else if (count++ < MaxTargets)
+                            edges[count - 1] = edge;
+                    });
+
+                    if (defer) {
+                        deferred[c].emplace_back(v);
+                    } else if (count == 1) {
+                        passage = edges[0];
+                    } else if (count > 1) {
+                        auto k = stream.randomBelow(count);
+                        if (k < MaxTargets)
+                            passage = edges[k];
+                        else
+                            forEachTarget(v, [&passage, &k, v](const vertex t, const std::size_t edge) {
+                                if (t >= v && k-- == 0)
+                                    passage = edge;
+                            });
+                    }
+                }
+            };
+            pool->parallelFor(chunks, pick);
+
+            // Every vertex before a deferred one has now been settled, so it is known which of its targets carved.
+            for (std::size_t c = 0; c < chunks; ++c)
+                for (const auto v: deferred[c]) {
+                    candidates.clear();
+                    forEachTarget(v, [&carved, &candidates, v](const vertex t, const std::size_t edge) {
+                        if (t >= v || !carved(t))
+                            candidates.emplace_back(edge);
+                    });
+                    if (!candidates.empty()) {
+                        passages[v - begin] = draws.element(candidates);
+                        seed.unvisited.visit(v);
+                    }
+                }
+
+            // Carve the passages of the round.
+            for (auto v = begin; v < end; ++v) {
+                const auto passage = passages[v - begin];
+                if (passage != NoPassage) {
+                    GraphUtils::carveEdge(passage, seed);
+                    seed.unvisited.visit(v);
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    /// The generator over a MazeTemplate is instantiated once, in ParallelBinaryTreeMazeGenerator.cpp.
+    extern template vertex ParallelBinaryTreeMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex ParallelBinaryTreeMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex ParallelBinaryTreeMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
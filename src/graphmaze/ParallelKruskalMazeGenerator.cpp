@@ -0,0 +1,60 @@
+/**
+ * ParallelKruskalMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "GraphUtils.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+#include "ParallelKruskalMazeGenerator.h"
+#include "ThreadPool.h"
+
+namespace spelunker::graphmaze {
+    ParallelKruskalMazeGenerator::ParallelKruskalMazeGenerator(const std::size_t numThreads)
+        : pool{std::make_shared<ThreadPool>(numThreads)} {}
+
+    ParallelKruskalMazeGenerator::ParallelKruskalMazeGenerator(std::shared_ptr<ThreadPool> pool) noexcept
+        : pool{std::move(pool)} {}
+
+    std::size_t ParallelKruskalMazeGenerator::partition(const std::uint64_t *in, const std::size_t n,
+                                                        std::uint64_t *out, const std::uint64_t pivot,
+                                                        std::vector<std::size_t> &counts) const {
+        // Count the light keys in each range, and then have each range write its keys at its offsets.
+        const auto ranges = pool->numRanges(n, Grain);
+        counts.assign(ranges + 1, 0);
+        pool->parallelFor(ranges, [in, n, ranges, pivot, &counts](const std::size_t r) {
+            std::size_t count = 0;
+            for (auto i = r * n / ranges; i < (r + 1) * n / ranges; ++i)
+                count += in[i] <= pivot;
+            counts[r + 1] = count;
+        });
+        for (std::size_t r = 0; r < ranges; ++r)
+            counts[r + 1] += counts[r];
+
+        const auto total = counts[ranges];
+        pool->parallelFor(ranges, [in, n, out, ranges, pivot, total, &counts](const std::size_t r) {
+            const auto begin = r * n / ranges;
+            auto light = counts[r];
+            auto heavy = total + begin - counts[r];
+            for (auto i = begin; i < (r + 1) * n / ranges; ++i) {
+                if (in[i] <= pivot)
+                    out[light++] = in[i];
+                else
+                    out[heavy++] = in[i];
+            }
+        });
+        return total;
+    }
+
+    template vertex ParallelKruskalMazeGenerator::carveOver(MazeSeed &seed) const;
+    template vertex ParallelKruskalMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    template vertex ParallelKruskalMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
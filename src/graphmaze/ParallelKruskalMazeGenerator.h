@@ -0,0 +1,272 @@
+/**
+ * ParallelKruskalMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <math/URBGUtils.h>
+
+#include "ConcurrentDisjointSets.h"
+#include "GraphUtils.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeSeed.h"
+#include "ThreadPool.h"
+
+namespace spelunker::graphmaze {
+
+    /**
+     * This is a MazeGenerator that works based on filter-Kruskal (Osipov, Sanders, and Singler, "The
+     * Filter-Kruskal Minimum Spanning Tree Algorithm", 2009), run across a pool of threads.
+     *
+     * Each edge is given a random key by a bijective mix of its index and a salt drawn from the engine, so that the
+     * keys are distinct, and the maze is the minimum spanning forest under these keys, which is unique. Rather than
+     * sorting all of the edges, the edges are split around a pivot key: the light edges are processed first, and
+     * then the heavy edges whose endpoints the light edges have already connected are filtered out before the heavy
+     * edges are processed in turn. Small sets of edges are sorted and joined sequentially by Kruskal's algorithm.
+     *
+     * Collecting the edges, partitioning them, and filtering them all run in parallel, with the finds of the
+     * filter searching a concurrent union-find, while the joining of the sorted edges runs on the calling thread.
+     * As the keys are uniform, the pivot is the midpoint of the range of keys, and needs no sampling.
+     *
+     * Since the maze is determined by the keys alone, it is the same for any number of threads, and
+     * generateFromSeed replays it exactly. As with KruskalMazeGenerator, the maze starts at an endpoint of the first
+     * passage carved.
+     */
+    class ParallelKruskalMazeGenerator final : public GenericMazeGenerator<ParallelKruskalMazeGenerator> {
+    public:
+        /// The largest number of edges that are sorted and joined directly, rather than split.
+        static constexpr std::size_t BaseSize = std::size_t{1} << 14;
+
+        /// The smallest number of edges worth filtering.
+        static constexpr std::size_t FilterSize = std::size_t{1} << 16;
+
+        /// The smallest number of edges or vertices worth handing to a thread.
+        static constexpr std::size_t Grain = std::size_t{1} << 14;
+
+        /**
+         * Create a generator with a pool of its own.
+         * @param numThreads the number of threads, or 0 for the number of hardware threads
+         */
+        explicit ParallelKruskalMazeGenerator(std::size_t numThreads = 0);
+
+        /// Create a generator that runs on a pool, which may be shared with other generators.
+        explicit ParallelKruskalMazeGenerator(std::shared_ptr<ThreadPool> pool) noexcept;
+
+        virtual ~ParallelKruskalMazeGenerator() final = default;
+
+        inline const std::shared_ptr<ThreadPool> &getPool() const noexcept { return pool; }
+
+    private:
+        std::shared_ptr<ThreadPool> pool;
+
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        /// The state of a run of filter-Kruskal.
+        template<typename T, typename S, typename R>
+        struct Run {
+            BasicMazeSeed<T, S, R> &seed;
+            ConcurrentDisjointSets &sets;
+            std::uint64_t salt;
+            std::size_t remaining;
+            vertex start;
+        };
+
+        /**
+         * Process the edges with keys in [lo,hi] in increasing order of key.
+         * @param run the state of the run
+         * @param keys the keys of the edges, whose order may be changed
+         * @param spare scratch space for as many keys
+         * @param n the number of edges
+         * @param lo the smallest possible key
+         * @param hi the largest possible key
+         */
+        template<typename T, typename S, typename R>
+        void filterKruskal(Run<T, S, R> &run, std::uint64_t *keys, std::uint64_t *spare, std::size_t n,
+                           std::uint64_t lo, std::uint64_t hi) const;
+
+        /**
+         * Stably partition in[0,n) into out, with the keys at most pivot first, and return their number.
+         * The counts of the ranges are kept in counts, which reuses its storage.
+         */
+        std::size_t partition(const std::uint64_t *in, std::size_t n, std::uint64_t *out, std::uint64_t pivot,
+                              std::vector<std::size_t> &counts) const;
+
+        /**
+         * Stably copy the keys of in[0,n) satisfying pred to out, and return their number.
+         * The predicate is evaluated once per key, as it may be expensive, and in is overwritten. The counts of the
+         * ranges are kept in counts, which reuses its storage.
+         */
+        template<typename P>
+        std::size_t filter(std::uint64_t *in, std::size_t n, std::uint64_t *out, P &&pred,
+                           std::vector<std::size_t> &counts) const;
+
+        /// The key of an edge, which is a bijection of its index for any salt (MurmurHash3's 64-bit finaliser).
+        static inline std::uint64_t edgeKey(const std::uint64_t salt, const std::size_t e) noexcept {
+            auto k = static_cast<std::uint64_t>(e) ^ salt;
+            k ^= k >> 33;
+            k *= 0xFF51AFD7ED558CCDull;
+            k ^= k >> 33;
+            k *= 0xC4CEB9FE1A85EC53ull;
+            k ^= k >> 33;
+            return k;
+        }
+
+        /// The index of the edge with a given key, inverting edgeKey.
+        static inline std::size_t keyEdge(const std::uint64_t salt, std::uint64_t k) noexcept {
+            k ^= k >> 33;
+            k *= 0x9CB4B2F8129337DBull;
+            k ^= k >> 33;
+            k *= 0x4F74430C22A54005ull;
+            k ^= k >> 33;
+            return static_cast<std::size_t>(k ^ salt);
+        }
+
+        friend class GenericMazeGenerator<ParallelKruskalMazeGenerator>;
+    };
+
+    template<typename T, typename S, typename R>
+    vertex ParallelKruskalMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
+        const auto &tmplt = seed.tmplt;
+        const auto numVertices = seed.numVertices;
+
+        // Count the edges that each range of vertices contributes from its lower endpoints, and then collect them,
+        // so that the edges are in the same order for any number of threads.
+        const auto ranges = pool->numRanges(numVertices, Grain);
+        auto &offsets = seed.context.getOffsetBuffer();
+        offsets.assign(ranges + 1, 0);
+        pool->parallelFor(ranges, [&tmplt, &offsets, numVertices, ranges](const std::size_t r) {
+            std::size_t count = 0;
+            for (auto v = r * numVertices / ranges; v < (r + 1) * numVertices / ranges; ++v)
+                tmplt.forEachNeighbour(v, [v, &count](const vertex t, std::size_t) { count += v < t; });
+            offsets[r + 1] = count;
+        });
+        for (std::size_t r = 0; r < ranges; ++r)
+            offsets[r + 1] += offsets[r];
+
+        // The key of an edge is a bijection of the edge, so from here on we work with the keys alone.
+        std::uint32_t words[2];
+        math::URBGUtils::fillWords(seed.rng, words, 2);
+        const auto salt = (static_cast<std::uint64_t>(words[0]) << 32) | words[1];
+
+        auto &keys = seed.context.getKeyBuffer();
+        auto &spare = seed.context.getSpareKeyBuffer();
+        keys.resize(offsets[ranges]);
+        spare.resize(offsets[ranges]);
+        pool->parallelFor(ranges, [&tmplt, &offsets, &keys, numVertices, ranges, salt](const std::size_t r) {
+            auto pos = offsets[r];
+            for (auto v = r * numVertices / ranges; v < (r + 1) * numVertices / ranges; ++v)
+                tmplt.forEachNeighbour(v, [v, &keys, &pos, salt](const vertex t, const std::size_t e) {
+                    if (v < t)
+                        keys[pos++] = edgeKey(salt, e);
+                });
+        });
+
+        auto &sets = seed.context.getConcurrentDisjointSets();
+        sets.resize(numVertices);
+        pool->parallelRanges(numVertices, Grain, [&sets](const std::size_t begin, const std::size_t end) {
+            sets.resetRange(begin, end);
+        });
+
+        Run<T, S, R> run{seed, sets, salt, numVertices > 0 ? numVertices - 1 : 0, 0};
+        filterKruskal(run, keys.data(), spare.data(), keys.size(), 0, std::numeric_limits<std::uint64_t>::max());
+        return run.start;
+    }
+
+    template<typename T, typename S, typename R>
+    void ParallelKruskalMazeGenerator::filterKruskal(Run<T, S, R> &run, std::uint64_t *keys, std::uint64_t *spare,
+                                                     const std::size_t n, const std::uint64_t lo,
+                                                     const std::uint64_t hi) const {
+        if (run.remaining == 0 || n == 0)
+            return;
+
+        if (n <= BaseSize || lo == hi) {
+            std::sort(keys, keys + n);
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto e = keyEdge(run.salt, keys[i]);
+                const auto &ei = run.seed.tmplt.edgeInfo(e);
+                if (!run.sets.unite(ei.v1, ei.v2))
+                    continue;
+
+                if (run.remaining == run.seed.numVertices - 1)
+                    run.start = ei.v1;
+                run.seed.unvisited.visit(ei.v1);
+                run.seed.unvisited.visit(ei.v2);
+                GraphUtils::carveEdge(e, run.seed);
+                if (--run.remaining == 0)
+                    return;
+            }
+            return;
+        }
+
+        // Split around the midpoint of the keys: the light edges go to the front of spare and the heavy to the back.
+        const auto pivot = lo + (hi - lo) / 2;
+        const auto light = partition(keys, n, spare, pivot, run.seed.context.getOffsetBuffer());
+        filterKruskal(run, spare, keys, light, lo, pivot);
+        if (run.remaining == 0)
+            return;
+
+        // Drop the heavy edges within a component, and process the rest. The finds of the filter cost about as much
+        // as those of the joining, so for a few edges it is cheaper to let them fall through to the joining.
+        if (n - light <= FilterSize) {
+            filterKruskal(run, spare + light, keys + light, n - light, pivot + 1, hi);
+            return;
+        }
+        const auto salt = run.salt;
+        auto &tmplt = run.seed.tmplt;
+        auto &sets = run.sets;
+        const auto heavy = filter(spare + light, n - light, keys + light, [salt, &tmplt, &sets](const std::uint64_t k) {
+            const auto &ei = tmplt.edgeInfo(keyEdge(salt, k));
+            return !sets.connected(ei.v1, ei.v2);
+        }, run.seed.context.getOffsetBuffer());
+        filterKruskal(run, keys + light, spare + light, heavy, pivot + 1, hi);
+    }
+
+    template<typename P>
+    std::size_t ParallelKruskalMazeGenerator::filter(std::uint64_t *in, const std::size_t n, std::uint64_t *out,
+                                                     P &&pred, std::vector<std::size_t> &counts) const {
+        // Compact the keys to keep at the front of each range, and then copy each range to its offset.
+        const auto ranges = pool->numRanges(n, Grain);
+        counts.assign(ranges + 1, 0);
+        pool->parallelFor(ranges, [in, n, ranges, &counts, &pred](const std::size_t r) {
+            const auto begin = r * n / ranges;
+            auto pos = begin;
+            for (auto i = begin; i < (r + 1) * n / ranges; ++i)
+                if (pred(in[i]))
+                    in[pos++] = in[i];
+            counts[r + 1] = pos - begin;
+        });
+        for (std::size_t r = 0; r < ranges; ++r)
+            counts[r + 1] += counts[r];
+
+        pool->parallelFor(ranges, [in, n, out, ranges, &counts](const std::size_t r) {
+            const auto begin = in + r * n / ranges;
+            std::copy(begin, begin + (counts[r + 1] - counts[r]), out + counts[r]);
+        });
+        return counts[ranges];
+    }
+
+    /// The generator over a MazeTemplate is instantiated once, in ParallelKruskalMazeGenerator.cpp.
+    extern template vertex ParallelKruskalMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex ParallelKruskalMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex ParallelKruskalMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
@@ -6,18 +6,43 @@
 
 #pragma once
 
+#include "GraphUtils.h"
+#include "GrowingTreeMazeGenerator.h"
 #include "MazeGenerator.h"
 #include "MazeGraph.h"
+#include "MazeSeed.h"
 
 namespace spelunker::graphmaze {
-    class PrimMazeGenerator final : public MazeGenerator {
+    class PrimMazeGenerator final : public GenericMazeGenerator<PrimMazeGenerator> {
     public:
         PrimMazeGenerator() = default;
         virtual ~PrimMazeGenerator() final = default;
 
-        virtual std::pair<const MazeGraph, const vertex> generate(const MazeGraph &tmplt) const final;
+    private:
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        friend class GenericMazeGenerator<PrimMazeGenerator>;
     };
-}
 
+    template<typename T, typename S, typename R>
+    vertex PrimMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
 
+        // The simplified Prim's algorithm is a growing tree that grows from a random cell.
+        return GrowingTreeMazeGenerator<RandomPolicy>::grow(seed, RandomPolicy{});
+    }
 
+    /// The generator over a MazeTemplate is instantiated once, in PrimMazeGenerator.cpp.
+    extern template vertex PrimMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex PrimMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex PrimMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
@@ -17,28 +17,155 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <tuple>
 
+#include <math/DrawBuffer.h>
+#include <types/Direction.h>
+#include <types/Exceptions.h>
+
+#include "GraphUtils.h"
 #include "MazeGenerator.h"
 #include "MazeGraph.h"
+#include "MazeSeed.h"
 
 namespace spelunker::graphmaze {
 
-    class SidewinderMazeGenerator final : public MazeGenerator {
+    class SidewinderMazeGenerator final : public GenericMazeGenerator<SidewinderMazeGenerator> {
     public:
         SidewinderMazeGenerator(double probability = 0.5);
         virtual ~SidewinderMazeGenerator() final = default;
 
-        virtual std::pair<const MazeGraph, const vertex> generate(const MazeGraph &tmplt) const final;
-
     private:
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        friend class GenericMazeGenerator<SidewinderMazeGenerator>;
+
         /**
          * The probability to carve east and extend the cell run.
          */
         double probability;
     };
-}
 
+    template<typename T, typename S, typename R>
+    vertex SidewinderMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
+        const auto &tmplt = seed.tmplt;
+
+        // Make sure that we have a binary tree function, which is needed to pick carving directions.
+        // The context has already evaluated it for each vertex type.
+        if (!tmplt.graphInfo().binaryTreeCandidates.has_value())
+            throw types::UnsupportedMazeGeneration();
+
+        // Keep track of the current run of cells.
+        auto &run = seed.context.getVertexBuffer();
+        auto &candidates = seed.context.getEdgeBuffer();
 
+        // We make a draw per cell, so draw the random words in blocks.
+        math::DrawBuffer<R> draws{seed.rng};
 
+        // Start at the first vertex and continue until we reach the end.
+        // We proceed as follows: continue to extend the run with the first direction in the
+        // candidate directions for the previous cell if possible (i.e. the next cell exists) and the
+        // probability is true.
+        const auto numVertices = tmplt.numVertices();
+        std::size_t numVerticesCovered = 0;
+        for (vertex v = 0; numVerticesCovered < numVertices && v < numVertices;) {
+            // Add this vertex to the run.
+            ++numVerticesCovered;
+            seed.unvisited.visit(v);
+            run.emplace_back(v);
 
+            // Now check if we can and want to extend this run, or alternatively,
+            // if we MUST extend this run (i.e. none of the other directions are valid).
+            const auto &vi = tmplt.vertexInfo(v);
+            const auto &dirs = seed.context.getCandidateDirections(vi.type);
+            if (dirs.empty())
+                throw types::UnsupportedMazeGeneration();
+            const auto dir = dirs.front();
+
+            // Check if any of the other directions are valid.
+            // This is a bit complicated. This idea is:
+            // Find if there is a direction (other than the first) in the direction list that
+            // leads to a valid, unvisited cell. (If not, then the first direction is the only valid
+            // direction, and we must follow it: this happens, for example, in the last row of
+            // a grid, where we must only carve east since there are no southern cells).
+            // Find the neighbour - if any - reached from v in direction d that is unvisited, and the edge to it.
+            const auto findUnvisited = [v, &seed](const types::Direction d, vertex &target, std::size_t &edge) {
+                auto found = false;
+                seed.tmplt.forEachNeighbourInDirection(v, d, [&](const vertex t, const std::size_t e) {
+                    if (!found && seed.unvisited.isUnvisited(t)) {
+                        found = true;
+                        target = t;
+                        edge = e;
+                    }
+                });
+                return found;
+            };
+            auto validDirs = std::find_if(std::next(dirs.cbegin()), dirs.cend(), [&findUnvisited](const auto d) {
+                vertex t{};
+                std::size_t e{};
+                return findUnvisited(d, t, e);
+            }) != dirs.cend();
+
+            if (draws.probability() < probability || !validDirs) {
+                // Find the edge - if any - corresponding to this direction.
+                vertex t{};
+                std::size_t e{};
+                if (findUnvisited(dir, t, e)) {
+                    // Carve the edge, and extend.
+                    GraphUtils::carveEdge(e, seed);
+                    v = t;
+                    continue;
+                }
+            }
+
+            // If we reach this point, it's because we either couldn't or didn't want to extend.
+            // We thus has to carve another direction to an unvisited vertex.
+            // Collect up the unvisited neighbours to which we can carve via the directions
+            // available for each vertex in the run.
+            candidates.clear();
+            for (const auto vs: run) {
+                // Get the directions for this vertex, omitting the first, and if cells exist
+                // in these directions, add the edges to candidates.
+                const auto &vs_dirs = seed.context.getCandidateDirections(tmplt.vertexInfo(vs).type);
+                for (auto d = std::next(vs_dirs.cbegin()); d != vs_dirs.cend(); ++d)
+                    tmplt.forEachNeighbourInDirection(vs, *d, [&](const vertex t, const std::size_t e) {
+                        if (seed.unvisited.isUnvisited(t))
+                            candidates.emplace_back(e);
+                    });
+            }
+
+            // If there are no candidates, then we cannot generate any outward vertices here.
+            // This will almost certainly result in a graph that is not perfect.
+            if (!candidates.empty()) {
+                // Now pick a random candidate.
+                const auto e = draws.element(candidates);
+
+                // And carve! We do not, however, mark this vertex as covered.
+                GraphUtils::carveEdge(e, seed);
+            }
+
+            // Clear the run, advance v, and loop.
+            run.clear();
+            ++v;
+        }
+        return 0;
+    }
+
+    /// The generator over a MazeTemplate is instantiated once, in SidewinderMazeGenerator.cpp.
+    extern template vertex SidewinderMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex SidewinderMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex SidewinderMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
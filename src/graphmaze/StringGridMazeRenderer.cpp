@@ -4,8 +4,6 @@
  * By Sebastian Raaphorst, 2018.
  */
 
-#include <boost/graph/adjacency_list.hpp>
-
 #include <array>
 #include <ostream>
 #include <string>
@@ -14,36 +12,59 @@
 #include <types/Exceptions.h>
 #include <types/Tessellations.h>
 
+#include "CarvedMaze.h"
 #include "GraphUtils.h"
 #include "MazeGraph.h"
+#include "MazeTemplate.h"
 #include "StringGridMazeRenderer.h"
 using namespace std::string_view_literals;
 
 namespace spelunker::graphmaze {
     StringGridMazeRenderer::StringGridMazeRenderer(std::ostream &o) : out(o) {}
 
-    bool StringGridMazeRenderer::wall(const MazeGraph &m, int x, int y, int w, int h, types::Direction d) {
-        const GraphInfo &info = GraphUtils::getGraphInfo(m);
+    bool StringGridMazeRenderer::wall(const MazeTemplate &m, int x, int y, int w, int h, types::Direction d) {
+        const GraphInfo &info = m.graphInfo();
 
         if (x < 0 || x >= w) return false;
         if (y < 0 || y >= h) return false;
 
-        const auto &ranker  = info.gridRankerMaps.front();
-        const auto iter = ranker.find({x,y});
-        if (iter == ranker.end()) return false;
+        const auto &ranker  = info.gridRankers.front();
+        const auto vOpt = ranker.find(x, y);
+        if (!vOpt.has_value()) return false;
 
-        // Check all the out edges to see which one matches d, if any.
-        const auto v = iter->second;
-        for (auto [eIter, eEnd] = boost::out_edges(v, m); eIter != eEnd; ++eIter) {
-            const auto props = boost::get(EdgeInfoPropertyTag(), m, *eIter);
-            if ((props.v1 == v && props.d1 == d) || (props.v2 == v && props.d2 == d))
-                return false;
-        }
+        // There is a wall unless the direction slot table has a passage in direction d.
+        return m.directionSlot(*vOpt, d) == MazeTemplate::NoSlot;
+    }
+
+    bool StringGridMazeRenderer::wall(const CarvedMaze &m, int x, int y, int w, int h, types::Direction d) {
+        const GraphInfo &info = m.getTemplate().graphInfo();
+
+        if (x < 0 || x >= w) return false;
+        if (y < 0 || y >= h) return false;
 
-        return true;
+        const auto &ranker  = info.gridRankers.front();
+        const auto vOpt = ranker.find(x, y);
+        if (!vOpt.has_value()) return false;
+
+        // There is a wall unless the edge in direction d has been carved.
+        return !m.hasPassage(*vOpt, d);
     }
 
     void StringGridMazeRenderer::render(const MazeGraph &m) {
+        // Freeze the maze once, so that each wall check is a direction slot table lookup.
+        render(MazeTemplate{m});
+    }
+
+    void StringGridMazeRenderer::render(const MazeTemplate &m) {
+        renderMaze(m, m.graphInfo());
+    }
+
+    void StringGridMazeRenderer::render(const CarvedMaze &m) {
+        renderMaze(m, m.getTemplate().graphInfo());
+    }
+
+    template<typename M>
+    void StringGridMazeRenderer::renderMaze(const M &m, const GraphInfo &info) {
         /**
          * First, we have to convert the Maze from an x by y grid into an (x+1) by (y+1) box drawing.
          * To determine cell (x,y) in the box drawing, we need the following cells from the Maze:
@@ -73,7 +94,6 @@ namespace spelunker::graphmaze {
 //        }
 //        ++w;
 //        ++h;
-        const GraphInfo &info = GraphUtils::getGraphInfo(m);
         if (info.type != types::TessellationType::GRID)
             throw types::UnsupportedRendering();
         const int w = info.width.value();
@@ -11,7 +11,9 @@
 #include <string>
 
 #include <types/Direction.h>
+#include "CarvedMaze.h"
 #include "MazeGraph.h"
+#include "MazeTemplate.h"
 using namespace std::string_view_literals;
 
 namespace spelunker::graphmaze {
@@ -27,11 +29,22 @@ namespace spelunker::graphmaze {
 
         void render(const MazeGraph &m);
 
+        /// Render a maze that has been frozen, e.g. to render it several times.
+        void render(const MazeTemplate &m);
+
+        /// Render a maze carved over a template.
+        void render(const CarvedMaze &m);
+
     private:
         std::ostream &out;
 
         /// A quick and dirty extractor to get a wall status from a Maze, returning false for illegal coordinates.
-        static bool wall(const MazeGraph &m, int x, int y, int w, int h, types::Direction d);
+        static bool wall(const MazeTemplate &m, int x, int y, int w, int h, types::Direction d);
+        static bool wall(const CarvedMaze &m, int x, int y, int w, int h, types::Direction d);
+
+        /// Render any maze for which there is a wall extractor above.
+        template<typename M>
+        void renderMaze(const M &m, const GraphInfo &info);
 
         /// The characters used in the box form of the maze representation. There has to be a better way to do this.
         static constexpr std::array<std::string_view, 16> boxchars = { " "sv,"╶"sv,"╷"sv,"┌"sv,"╴"sv,"─"sv,"┐"sv,"┬"sv,"╵"sv,"└"sv,"│"sv,"├"sv,"┘"sv,"┴"sv,"┤"sv,"┼"sv };
@@ -0,0 +1,187 @@
+/**
+ * TemplateCache.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include <types/AxialOrientation.h>
+#include <types/Exceptions.h>
+#include <types/Tessellations.h>
+
+#include "GraphUtils.h"
+#include "MazeTemplate.h"
+#include "TemplateCache.h"
+
+namespace spelunker::graphmaze {
+    using types::AxialOrientation;
+    using types::TessellationType;
+
+    TemplateKey TemplateKey::grid(const int width, const int height) {
+        return TemplateKey{TessellationType::GRID, width, height, AxialOrientation::DISCONNECTED, AxialOrientation::DISCONNECTED, 0};
+    }
+
+    TemplateKey TemplateKey::cylinder(const int width, const int height) {
+        return TemplateKey{TessellationType::GRID, width, height, AxialOrientation::LOOPED, AxialOrientation::DISCONNECTED, 0};
+    }
+
+    TemplateKey TemplateKey::torus(const int width, const int height) {
+        return TemplateKey{TessellationType::GRID, width, height, AxialOrientation::LOOPED, AxialOrientation::LOOPED, 0};
+    }
+
+    TemplateKey TemplateKey::mobiusStrip(const int width, const int height) {
+        return TemplateKey{TessellationType::GRID, width, height, AxialOrientation::REVERSE_LOOPED, AxialOrientation::DISCONNECTED, 0};
+    }
+
+    TemplateKey TemplateKey::kleinBottle(const int width, const int height) {
+        return TemplateKey{TessellationType::GRID, width, height, AxialOrientation::REVERSE_LOOPED, AxialOrientation::LOOPED, 0};
+    }
+
+    TemplateKey TemplateKey::projectivePlane(const int width, const int height) {
+        return TemplateKey{TessellationType::GRID, width, height, AxialOrientation::REVERSE_LOOPED, AxialOrientation::REVERSE_LOOPED, 0};
+    }
+
+    TemplateKey TemplateKey::circular(const int radius) {
+        return TemplateKey{TessellationType::CIRCULAR, 0, 0, AxialOrientation::DISCONNECTED, AxialOrientation::DISCONNECTED, radius};
+    }
+
+    TemplateKey TemplateKey::spherical(const int diameter) {
+        return TemplateKey{TessellationType::SPHERICAL, 0, 0, AxialOrientation::DISCONNECTED, AxialOrientation::DISCONNECTED, diameter};
+    }
+
+    TemplateKey TemplateKey::octagonalGrid(const int width, const int height) {
+        return TemplateKey{TessellationType::OCTAGONAL, width, height, AxialOrientation::DISCONNECTED, AxialOrientation::DISCONNECTED, 0};
+    }
+
+    TemplateKey TemplateKey::octagonalCylinder(const int width, const int height) {
+        return TemplateKey{TessellationType::OCTAGONAL, width, height, AxialOrientation::LOOPED, AxialOrientation::DISCONNECTED, 0};
+    }
+
+    TemplateKey TemplateKey::octagonalTorus(const int width, const int height) {
+        return TemplateKey{TessellationType::OCTAGONAL, width, height, AxialOrientation::LOOPED, AxialOrientation::LOOPED, 0};
+    }
+
+    bool TemplateKey::operator==(const TemplateKey &other) const noexcept {
+        return type == other.type
+            && width == other.width
+            && height == other.height
+            && xorientation == other.xorientation
+            && yorientation == other.yorientation
+            && radius == other.radius;
+    }
+
+    std::size_t TemplateKeyHash::operator()(const TemplateKey &key) const noexcept {
+        // Combine the fields as in boost::hash_combine.
+        std::size_t seed = 0;
+        const auto combine = [&seed](const std::size_t h) {
+            seed ^= h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+        };
+        combine(std::hash<int>{}(static_cast<int>(key.type)));
+        combine(std::hash<int>{}(key.width));
+        combine(std::hash<int>{}(key.height));
+        combine(std::hash<int>{}(static_cast<int>(key.xorientation)));
+        combine(std::hash<int>{}(static_cast<int>(key.yorientation)));
+        combine(std::hash<int>{}(key.radius));
+        return seed;
+    }
+
+    TemplateCache::TemplateCache(const std::size_t capacity)
+        : capacity{capacity} {
+        if (capacity == 0)
+            throw std::invalid_argument("Template cache capacity must be positive.");
+    }
+
+    TemplateCache::TemplateHandle TemplateCache::get(const TemplateKey &key) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            const auto iter = index.find(key);
+            if (iter != index.end()) {
+                ++statistics.hits;
+                entries.splice(entries.begin(), entries, iter->second);
+                return iter->second->second;
+            }
+            ++statistics.misses;
+        }
+
+        // Build outside of the lock.
+        TemplateHandle handle = std::make_shared<const MazeTemplate>(makeTemplate(key));
+
+        std::lock_guard<std::mutex> lock{mutex};
+
+        // Another thread may have built the same template in the meantime: if so, share theirs.
+        const auto iter = index.find(key);
+        if (iter != index.end()) {
+            entries.splice(entries.begin(), entries, iter->second);
+            return iter->second->second;
+        }
+
+        entries.emplace_front(key, handle);
+        index.emplace(key, entries.begin());
+        while (entries.size() > capacity) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+            ++statistics.evictions;
+        }
+        return handle;
+    }
+
+    std::size_t TemplateCache::size() const {
+        std::lock_guard<std::mutex> lock{mutex};
+        return entries.size();
+    }
+
+    TemplateCache::Statistics TemplateCache::getStatistics() const {
+        std::lock_guard<std::mutex> lock{mutex};
+        return statistics;
+    }
+
+    void TemplateCache::clear() {
+        std::lock_guard<std::mutex> lock{mutex};
+        index.clear();
+        entries.clear();
+    }
+
+    MazeTemplate TemplateCache::makeTemplate(const TemplateKey &key) {
+        const auto x = key.xorientation;
+        const auto y = key.yorientation;
+        const auto w = key.width;
+        const auto h = key.height;
+
+        switch (key.type) {
+            case TessellationType::GRID:
+                if (x == AxialOrientation::DISCONNECTED && y == AxialOrientation::DISCONNECTED)
+                    return GraphUtils::makeGridTemplate(w, h);
+                if (x == AxialOrientation::LOOPED && y == AxialOrientation::DISCONNECTED)
+                    return GraphUtils::makeCylinderTemplate(w, h);
+                if (x == AxialOrientation::LOOPED && y == AxialOrientation::LOOPED)
+                    return GraphUtils::makeTorusTemplate(w, h);
+                if (x == AxialOrientation::REVERSE_LOOPED && y == AxialOrientation::DISCONNECTED)
+                    return GraphUtils::makeMobiusStripTemplate(w, h);
+                if (x == AxialOrientation::REVERSE_LOOPED && y == AxialOrientation::LOOPED)
+                    return GraphUtils::makeKleinBottleTemplate(w, h);
+                if (x == AxialOrientation::REVERSE_LOOPED && y == AxialOrientation::REVERSE_LOOPED)
+                    return GraphUtils::makeProjectivePlaneTemplate(w, h);
+                break;
+            case TessellationType::CIRCULAR:
+                return GraphUtils::makeCircularTemplate(key.radius);
+            case TessellationType::SPHERICAL:
+                return GraphUtils::makeSphericalTemplate(key.radius);
+            case TessellationType::OCTAGONAL:
+                if (x == AxialOrientation::DISCONNECTED && y == AxialOrientation::DISCONNECTED)
+                    return GraphUtils::makeOctagonalGridTemplate(w, h);
+                if (x == AxialOrientation::LOOPED && y == AxialOrientation::DISCONNECTED)
+                    return GraphUtils::makeOctagonalCylinderTemplate(w, h);
+                if (x == AxialOrientation::LOOPED && y == AxialOrientation::LOOPED)
+                    return GraphUtils::makeOctagonalTorusTemplate(w, h);
+                break;
+            default:
+                break;
+        }
+        throw types::UnsupportedTemplateGeneration();
+    }
+}
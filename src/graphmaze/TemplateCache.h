@@ -0,0 +1,129 @@
+/**
+ * TemplateCache.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <types/AxialOrientation.h>
+#include <types/Tessellations.h>
+
+#include "MazeTemplate.h"
+
+namespace spelunker::graphmaze {
+    /// The parameters that determine a template produced by GraphUtils.
+    /**
+     * Fields that do not apply to a tessellation are left at zero / DISCONNECTED, so that each template has
+     * exactly one key. Use the static functions, which mirror the GraphUtils functions, to create keys.
+     * For spherical templates, radius holds the diameter (in rows) of the sphere.
+     */
+    struct TemplateKey {
+        types::TessellationType type = types::TessellationType::GRID;
+        int width = 0;
+        int height = 0;
+        types::AxialOrientation xorientation = types::AxialOrientation::DISCONNECTED;
+        types::AxialOrientation yorientation = types::AxialOrientation::DISCONNECTED;
+        int radius = 0;
+
+        static TemplateKey grid(int width, int height);
+        static TemplateKey cylinder(int width, int height);
+        static TemplateKey torus(int width, int height);
+        static TemplateKey mobiusStrip(int width, int height);
+        static TemplateKey kleinBottle(int width, int height);
+        static TemplateKey projectivePlane(int width, int height);
+        static TemplateKey circular(int radius);
+        static TemplateKey spherical(int diameter);
+        static TemplateKey octagonalGrid(int width, int height);
+        static TemplateKey octagonalCylinder(int width, int height);
+        static TemplateKey octagonalTorus(int width, int height);
+
+        bool operator==(const TemplateKey &other) const noexcept;
+        bool operator!=(const TemplateKey &other) const noexcept { return !(*this == other); }
+    };
+
+    /// A hash for TemplateKey.
+    struct TemplateKeyHash {
+        std::size_t operator()(const TemplateKey &key) const noexcept;
+    };
+
+    /// A thread-safe, size-bounded, least-recently-used cache of immutable templates.
+    /**
+     * Building a template is expensive compared to generating a maze on it, and templates never change once
+     * built, so services that keep asking for the same few templates can share them. The cache hands out shared
+     * read-only handles, which remain valid after the template is evicted for as long as they are held.
+     *
+     * Templates are built outside of the lock, so a slow build does not block requests for other templates. If
+     * two threads miss on the same key at once, both build it, and the first to finish is kept.
+     */
+    class TemplateCache final {
+    public:
+        /// A shared handle to a cached template.
+        using TemplateHandle = std::shared_ptr<const MazeTemplate>;
+
+        /// Counters of the activity of the cache.
+        struct Statistics {
+            std::size_t hits = 0;
+            std::size_t misses = 0;
+            std::size_t evictions = 0;
+        };
+
+        /**
+         * Create an empty cache.
+         * @param capacity the maximum number of templates held, which must be positive
+         */
+        explicit TemplateCache(std::size_t capacity);
+
+        TemplateCache(const TemplateCache&) = delete;
+        TemplateCache &operator=(const TemplateCache&) = delete;
+        ~TemplateCache() = default;
+
+        /**
+         * Get the template for a key, building it if it is not in the cache.
+         * @param key the parameters of the template
+         * @return a shared handle to the template
+         * @throws UnsupportedTemplateGeneration if no template corresponds to the key
+         */
+        TemplateHandle get(const TemplateKey &key);
+
+        /// The maximum number of templates held.
+        inline std::size_t getCapacity() const noexcept { return capacity; }
+
+        /// The number of templates currently held.
+        std::size_t size() const;
+
+        /// A snapshot of the counters.
+        Statistics getStatistics() const;
+
+        /// Drop all templates. Outstanding handles remain valid, and the counters are kept.
+        void clear();
+
+        /**
+         * Build the template for a key without caching it.
+         * @param key the parameters of the template
+         * @return the template
+         * @throws UnsupportedTemplateGeneration if no template corresponds to the key
+         */
+        static MazeTemplate makeTemplate(const TemplateKey &key);
+
+    private:
+        using Entry = std::pair<TemplateKey, TemplateHandle>;
+        using EntryList = std::list<Entry>;
+
+        const std::size_t capacity;
+
+        mutable std::mutex mutex;
+
+        /// The entries, from most to least recently used.
+        EntryList entries;
+        std::unordered_map<TemplateKey, EntryList::iterator, TemplateKeyHash> index;
+        Statistics statistics;
+    };
+}
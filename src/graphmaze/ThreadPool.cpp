@@ -0,0 +1,117 @@
+/**
+ * ThreadPool.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "ThreadPool.h"
+
+namespace spelunker::graphmaze {
+    ThreadPool::ThreadPool(std::size_t numThreads) {
+        if (numThreads == 0)
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+        workers.reserve(numThreads - 1);
+        for (std::size_t i = 1; i < numThreads; ++i)
+            workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (auto &worker: workers)
+            worker.join();
+    }
+
+    std::size_t ThreadPool::numRanges(const std::size_t n, const std::size_t grain) const noexcept {
+        const auto most = std::max<std::size_t>(1, n / std::max<std::size_t>(1, grain));
+        return std::min(most, size() * RangesPerThread);
+    }
+
+    void ThreadPool::run(const std::size_t numChunks, const std::function<void(std::size_t)> &task) {
+        if (numChunks == 0)
+            return;
+        if (workers.empty() || numChunks == 1) {
+            for (std::size_t chunk = 0; chunk < numChunks; ++chunk)
+                task(chunk);
+            return;
+        }
+
+        Batch batch;
+        batch.task = &task;
+        batch.numChunks = numChunks;
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            batches.emplace_back(&batch);
+        }
+        workAvailable.notify_all();
+
+        const auto ran = work(batch);
+
+        // Wait for the chunks claimed by the workers, and for the workers to let go of the batch.
+        std::unique_lock<std::mutex> lock{mutex};
+        batch.finished += ran;
+        retire(batch);
+        batchFinished.wait(lock, [&batch] { return batch.finished == batch.numChunks && batch.users == 0; });
+        if (batch.error)
+            std::rethrow_exception(batch.error);
+    }
+
+    std::size_t ThreadPool::work(Batch &batch) {
+        std::size_t ran = 0;
+        for (auto chunk = batch.next++; chunk < batch.numChunks; chunk = batch.next++) {
+            try {
+                (*batch.task)(chunk);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock{mutex};
+                if (!batch.error)
+                    batch.error = std::current_exception();
+
+                // Claim all of the chunks left, and count them as finished.
+                const auto skipped = batch.next.exchange(batch.numChunks);
+                if (skipped < batch.numChunks)
+                    batch.finished += batch.numChunks - skipped;
+            }
+            ++ran;
+        }
+        return ran;
+    }
+
+    void ThreadPool::retire(Batch &batch) {
+        const auto pos = std::find(batches.begin(), batches.end(), &batch);
+        if (pos != batches.end())
+            batches.erase(pos);
+    }
+
+    void ThreadPool::workerLoop() {
+        std::unique_lock<std::mutex> lock{mutex};
+        while (true) {
+            workAvailable.wait(lock, [this] { return stopping || !batches.empty(); });
+            if (stopping)
+                return;
+
+            auto &batch = *batches.front();
+            ++batch.users;
+            lock.unlock();
+            const auto ran = work(batch);
+            lock.lock();
+
+            // Every chunk of the batch has now been claimed.
+            retire(batch);
+            batch.finished += ran;
+            --batch.users;
+            if (batch.finished == batch.numChunks && batch.users == 0)
+                batchFinished.notify_all();
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ * ThreadPool.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spelunker::graphmaze {
+    /// A fixed set of worker threads that run the chunks of parallel loops.
+    /**
+     * The parallel generators split their work into chunks indexed from 0 and hand them to parallelFor, which
+     * blocks until every chunk has run. The calling thread works through chunks alongside the workers, so a pool of
+     * n threads has n - 1 workers, and a pool of one thread runs everything on the caller.
+     *
+     * Chunks are claimed in index order, but may finish in any order: a loop whose result must not depend on the
+     * number of threads should have each chunk write only to its own part of the output.
+     *
+     * Several threads may call parallelFor on the same pool at once, and a chunk may itself call parallelFor: a
+     * caller always works on its own loop, so this cannot deadlock. If chunks throw, the remaining chunks are skipped
+     * and the first exception is rethrown by parallelFor.
+     */
+    class ThreadPool final {
+    public:
+        /**
+         * Start a pool.
+         * @param numThreads the number of threads that work on a loop, including the caller, or 0 for the number of
+         *                   hardware threads
+         */
+        explicit ThreadPool(std::size_t numThreads = 0);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool &operator=(const ThreadPool&) = delete;
+
+        /// Stop the workers, which must not be running any loop.
+        ~ThreadPool();
+
+        /// The number of threads that work on a loop, including the caller.
+        inline std::size_t size() const noexcept { return workers.size() + 1; }
+
+        /**
+         * Run f(0), ..., f(numChunks - 1) across the pool, and wait for them all to finish.
+         * @tparam F a callable taking (std::size_t chunk)
+         * @param numChunks the number of chunks
+         * @param f the callable
+         */
+        template<typename F>
+        inline void parallelFor(const std::size_t numChunks, F &&f) {
+            // The callable outlives the loop, so it is wrapped by reference, which std::function stores in place.
+            run(numChunks, std::function<void(std::size_t)>{std::ref(f)});
+        }
+
+        /**
+         * Split [0,n) into about size() ranges per thread of at least grain indices each, and run f(begin, end) for
+         * each range across the pool.
+         * @tparam F a callable taking (std::size_t begin, std::size_t end)
+         * @param n the size of the range
+         * @param grain the smallest number of indices worth handing to a thread
+         * @param f the callable
+         */
+        template<typename F>
+        void parallelRanges(std::size_t n, std::size_t grain, F &&f);
+
+        /**
+         * The number of ranges into which parallelRanges splits [0,n).
+         * This is deterministic, so that callers may size per-range storage in advance.
+         */
+        std::size_t numRanges(std::size_t n, std::size_t grain) const noexcept;
+
+    private:
+        /// A call to parallelFor in progress, which lives on the stack of its caller.
+        struct Batch {
+            const std::function<void(std::size_t)> *task;
+            std::size_t numChunks;
+            std::atomic<std::size_t> next{0};
+
+            // Guarded by the mutex of the pool.
+            std::size_t finished = 0;
+            std::size_t users = 0;
+            std::exception_ptr error;
+        };
+
+        /// The number of ranges per thread made by parallelRanges, to even out the load.
+        static constexpr std::size_t RangesPerThread = 4;
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable workAvailable;
+        std::condition_variable batchFinished;
+        std::deque<Batch*> batches;
+        bool stopping = false;
+
+        void run(std::size_t numChunks, const std::function<void(std::size_t)> &task);
+
+        /// Run unclaimed chunks of a batch until there are none left, and return the number run.
+        std::size_t work(Batch &batch);
+
+        /// Stop offering a batch to the workers, which requires the lock.
+        void retire(Batch &batch);
+
+        void workerLoop();
+    };
+
+    template<typename F>
+    void ThreadPool::parallelRanges(const std::size_t n, const std::size_t grain, F &&f) {
+        const auto ranges = numRanges(n, grain);
+        parallelFor(ranges, [n, ranges, &f](const std::size_t r) {
+            f(r * n / ranges, (r + 1) * n / ranges);
+        });
+    }
+}
@@ -0,0 +1,51 @@
+/**
+ * VisitedSet.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstdint>
+
+#include <math/BitUtils.h>
+
+#include "VisitedSet.h"
+
+namespace spelunker::graphmaze {
+    using math::BitUtils;
+
+    VisitedSet::VisitedSet(const std::size_t numVertices) {
+        reset(numVertices);
+    }
+
+    void VisitedSet::reset(const std::size_t n) {
+        numVertices = n;
+        words.assign(BitUtils::numWords(n), ~std::uint64_t{0});
+
+        // Clear the bits past the last vertex.
+        if (const auto tail = n % BitUtils::WordBits)
+            words.back() = (std::uint64_t{1} << tail) - 1;
+    }
+
+    std::size_t VisitedSet::countUnvisited() const noexcept {
+        std::size_t count = 0;
+        for (const auto word: words)
+            count += BitUtils::popCount(word);
+        return count;
+    }
+
+    std::size_t VisitedSet::findFirstUnvisited(const std::size_t from) const noexcept {
+        if (from >= numVertices)
+            return npos;
+
+        auto idx = from / BitUtils::WordBits;
+
+        // Mask off the bits before from in the first word.
+        auto word = words[idx] & (~std::uint64_t{0} << (from % BitUtils::WordBits));
+        while (!word) {
+            if (++idx == words.size())
+                return npos;
+            word = words[idx];
+        }
+        return idx * BitUtils::WordBits + BitUtils::countTrailingZeros(word);
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * VisitedSet.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <math/BitUtils.h>
+
+namespace spelunker::graphmaze {
+    /// A word-packed set of the vertices that have yet to be visited during maze generation.
+    /**
+     * Each vertex is represented by one bit, which is set while the vertex is unvisited. Checking or visiting a
+     * vertex is a single word operation, and searching for or counting the unvisited vertices proceeds a word
+     * (64 vertices) at a time. The bits past the last vertex are always clear.
+     *
+     * Vertices are represented as std::size_t, which is the vertex descriptor of a MazeGraph.
+     */
+    class VisitedSet final {
+    public:
+        /// Returned by searches that find nothing.
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        VisitedSet() = default;
+
+        /// Create a set of numVertices vertices, all unvisited.
+        explicit VisitedSet(std::size_t numVertices);
+
+        /**
+         * Mark all of the vertices as unvisited, resizing to numVertices.
+         * This is linear in the number of words, and reuses the existing storage where possible.
+         */
+        void reset(std::size_t numVertices);
+
+        /// The number of vertices in the set.
+        inline std::size_t size() const noexcept { return numVertices; }
+
+        inline bool isUnvisited(const std::size_t v) const noexcept {
+            return (words[v / math::BitUtils::WordBits] >> (v % math::BitUtils::WordBits)) & 1;
+        }
+
+        inline bool isVisited(const std::size_t v) const noexcept {
+            return !isUnvisited(v);
+        }
+
+        /// Mark a vertex as visited.
+        inline void visit(const std::size_t v) noexcept {
+            words[v / math::BitUtils::WordBits] &= ~(std::uint64_t{1} << (v % math::BitUtils::WordBits));
+        }
+
+        /**
+         * Mark a vertex as visited.
+         * @return true if the vertex was previously unvisited, and false otherwise
+         */
+        inline bool tryVisit(const std::size_t v) noexcept {
+            auto &word = words[v / math::BitUtils::WordBits];
+            const auto mask = std::uint64_t{1} << (v % math::BitUtils::WordBits);
+            const bool unvisited = word & mask;
+            word &= ~mask;
+            return unvisited;
+        }
+
+        /// Count the unvisited vertices.
+        std::size_t countUnvisited() const noexcept;
+
+        /**
+         * Find the first unvisited vertex at or after a given vertex.
+         * @param from the vertex at which to begin the search
+         * @return the first unvisited vertex v >= from, or npos if there is none
+         */
+        std::size_t findFirstUnvisited(std::size_t from = 0) const noexcept;
+
+    private:
+        std::size_t numVertices = 0;
+        std::vector<std::uint64_t> words;
+    };
+}
@@ -0,0 +1,24 @@
+/**
+ * WeightedPrimMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <utility>
+
+#include <math/DrawBuffer.h>
+
+#include "GraphUtils.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+#include "WeightedPrimMazeGenerator.h"
+
+namespace spelunker::graphmaze {
+    WeightedPrimMazeGenerator::WeightedPrimMazeGenerator(WeightFunction weight) noexcept
+        : weight{std::move(weight)} {}
+
+    template vertex WeightedPrimMazeGenerator::carveOver(MazeSeed &seed) const;
+    template vertex WeightedPrimMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    template vertex WeightedPrimMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
@@ -0,0 +1,115 @@
+/**
+ * WeightedPrimMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include <math/DrawBuffer.h>
+
+#include "GraphUtils.h"
+#include "IndexedHeap.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeSeed.h"
+
+namespace spelunker::graphmaze {
+
+    /**
+     * This is a MazeGenerator that works based on Prim's algorithm proper, over random edge weights: the maze is the
+     * minimum spanning tree of the weights, grown from a random vertex by repeatedly carving the lightest edge from
+     * the maze to an unvisited vertex.
+     *
+     * PrimMazeGenerator is the simplified variant, which picks a random vertex of the maze to grow from and
+     * re-examines its neighbours each time. Here, each unvisited vertex next to the maze is kept in the IndexedHeap of
+     * the GenerationContext, keyed by the weight of the lightest edge joining it to the maze, so each edge is weighed
+     * once, when its first endpoint joins the maze, and costs at most one O(log n) heap operation.
+     *
+     * By default, every edge has a weight drawn uniformly from [0,1). A weight function may instead map each edge
+     * and its uniform draw to a weight, e.g. to scale the draws of the edges in one direction to bias the passages
+     * that way, or to ignore the draw and give the edges a fixed weight field.
+     */
+    class WeightedPrimMazeGenerator final : public GenericMazeGenerator<WeightedPrimMazeGenerator> {
+    public:
+        /// A function from the index of a template edge and a uniform draw from [0,1) to the weight of the edge.
+        using WeightFunction = std::function<double(std::size_t, double)>;
+
+        /// Create a generator over uniform random weights.
+        WeightedPrimMazeGenerator() = default;
+
+        /// Create a generator over the weights given by a function.
+        explicit WeightedPrimMazeGenerator(WeightFunction weight) noexcept;
+
+        virtual ~WeightedPrimMazeGenerator() final = default;
+
+    private:
+        WeightFunction weight;
+
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        friend class GenericMazeGenerator<WeightedPrimMazeGenerator>;
+    };
+
+    template<typename T, typename S, typename R>
+    vertex WeightedPrimMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
+        // The frontier, and for each vertex on it, the lightest edge joining it to the maze.
+        auto &frontier = seed.context.getIndexedHeap();
+        auto &via = seed.context.getEdgeBuffer();
+        frontier.reset(seed.numVertices);
+        via.resize(seed.numVertices);
+
+        // Each edge makes a draw when it is weighed, so draw the random words in blocks.
+        math::DrawBuffer<R> draws{seed.rng};
+
+        const auto start = GraphUtils::randomStartVertex(seed.rng, seed.tmplt);
+        auto v = start;
+        seed.unvisited.visit(v);
+
+        while (true) {
+            // Weigh the edges from v to the unvisited vertices, and keep the lightest edge to each.
+            seed.tmplt.forEachNeighbour(v, [this, &seed, &frontier, &via, &draws](const vertex t, const std::size_t e) {
+                if (!seed.unvisited.isUnvisited(t))
+                    return;
+
+                const auto r = draws.probability();
+                const auto w = weight ? weight(e, r) : r;
+                if (!frontier.contains(t)) {
+                    frontier.push(t, w);
+                    via[t] = e;
+                } else if (w < frontier.key(t)) {
+                    frontier.decreaseKey(t, w);
+                    via[t] = e;
+                }
+            });
+
+            if (frontier.empty())
+                break;
+
+            // Carve the lightest edge from the maze.
+            v = frontier.pop();
+            seed.unvisited.visit(v);
+            GraphUtils::carveEdge(via[v], seed);
+        }
+
+        return start;
+    }
+
+    /// The generator over a MazeTemplate is instantiated once, in WeightedPrimMazeGenerator.cpp.
+    extern template vertex WeightedPrimMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex WeightedPrimMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex WeightedPrimMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
@@ -0,0 +1,20 @@
+/**
+ * WilsonMazeGenerator.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <math/DrawBuffer.h>
+
+#include "GraphUtils.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeTemplate.h"
+#include "WilsonMazeGenerator.h"
+
+namespace spelunker::graphmaze {
+
+    template vertex WilsonMazeGenerator::carveOver(MazeSeed &seed) const;
+    template vertex WilsonMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    template vertex WilsonMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
@@ -0,0 +1,96 @@
+/**
+ * WilsonMazeGenerator.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <math/DrawBuffer.h>
+
+#include "GraphUtils.h"
+#include "MazeGenerator.h"
+#include "MazeGraph.h"
+#include "MazeSeed.h"
+#include "VisitedSet.h"
+
+namespace spelunker::graphmaze {
+
+    /**
+     * This is a MazeGenerator that works based on Wilson's algorithm, which, like Aldous-Broder, generates every
+     * spanning tree of the template with equal probability, but in mean hitting time rather than cover time.
+     *
+     * Starting from a tree of one random vertex, each vertex not yet in the tree in turn begins a random walk that
+     * runs until it hits the tree, and the loop-erased path of the walk is then added to the tree. Rather than keep
+     * the path as a list and erase its loops as they close, the walk records the step last taken from each vertex in
+     * a next-pointer array: revisiting a vertex overwrites its pointer, so retracing the pointers from the start of
+     * the walk follows exactly the loop-erased path.
+     *
+     * Each step picks one of the edges of the current vertex uniformly, so this works over any template, including
+     * circular and octagonal ones, and over multigraphs. As with Aldous-Broder, the template must be connected.
+     */
+    class WilsonMazeGenerator final : public GenericMazeGenerator<WilsonMazeGenerator> {
+    public:
+        WilsonMazeGenerator() = default;
+        virtual ~WilsonMazeGenerator() final = default;
+
+    private:
+        /**
+         * Carve a maze over a template of type T, reporting the passages carved to a sink of type S, and drawing
+         * from an engine of type R.
+         * @tparam T the template type
+         * @tparam S the sink type
+         * @tparam R the engine type
+         * @param seed the seed, with no passages carved and all vertices unvisited
+         * @return the vertex at which generation started
+         */
+        template<typename T, typename S, typename R>
+        vertex carveOver(BasicMazeSeed<T, S, R> &seed) const;
+
+        friend class GenericMazeGenerator<WilsonMazeGenerator>;
+    };
+
+    template<typename T, typename S, typename R>
+    vertex WilsonMazeGenerator::carveOver(BasicMazeSeed<T, S, R> &seed) const {
+        // The next-pointer array: the vertex to which, and the edge along which, the walk last stepped from each
+        // vertex. The entries are only read for vertices on the current walk, so they need no initialisation.
+        auto &next = seed.context.getVertexBuffer();
+        auto &nextEdge = seed.context.getEdgeBuffer();
+        next.resize(seed.numVertices);
+        nextEdge.resize(seed.numVertices);
+
+        // The tree is the set of visited vertices, and begins with a random vertex.
+        const auto root = GraphUtils::randomStartVertex(seed.rng, seed.tmplt);
+        seed.unvisited.visit(root);
+
+        // A random walk makes a draw per step, so draw the random words in blocks.
+        math::DrawBuffer<R> draws{seed.rng};
+
+        for (auto u = seed.unvisited.findFirstUnvisited(); u != VisitedSet::npos;
+             u = seed.unvisited.findFirstUnvisited(u + 1)) {
+            // Walk from u until we hit the tree, recording the step taken from each vertex along the way.
+            for (auto v = u; seed.unvisited.isUnvisited(v); v = next[v]) {
+                auto k = draws.below(seed.tmplt.degree(v));
+                seed.tmplt.forEachNeighbour(v, [v, &k, &next, &nextEdge](const vertex t, const std::size_t e) {
+                    if (k-- == 0) {
+                        next[v] = t;
+                        nextEdge[v] = e;
+                    }
+                });
+            }
+
+            // Add the loop-erased walk to the tree.
+            for (auto v = u; seed.unvisited.tryVisit(v); v = next[v])
+                GraphUtils::carveEdge(nextEdge[v], seed);
+        }
+
+        return root;
+    }
+
+    /// The generator over a MazeTemplate is instantiated once, in WilsonMazeGenerator.cpp.
+    extern template vertex WilsonMazeGenerator::carveOver(MazeSeed &seed) const;
+    extern template vertex WilsonMazeGenerator::carveOver(ObservedMazeSeed &seed) const;
+    extern template vertex WilsonMazeGenerator::carveOver(SeededMazeSeed &seed) const;
+}
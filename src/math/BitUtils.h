@@ -0,0 +1,65 @@
+/**
+ * BitUtils.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Word-level bit manipulation used by the packed bitsets.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace spelunker::math {
+    /**
+     * A class with purely static members to offer bit counting operations on 64-bit words.
+     * These compile down to single instructions (tzcnt / popcnt) where the compiler supports them.
+     */
+    class BitUtils final {
+    private:
+        BitUtils() = default;
+        ~BitUtils() = default;
+
+    public:
+        /// The number of bits in a word.
+        static constexpr unsigned int WordBits = 64;
+
+        /**
+         * Count the trailing zeros of a word, i.e. find the index of its lowest set bit.
+         * @param word the word, which must be nonzero
+         * @return the index of the lowest set bit
+         */
+        static inline unsigned int countTrailingZeros(const std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned int>(__builtin_ctzll(word));
+#else
+            unsigned int n = 0;
+            for (auto w = word; !(w & 1); w >>= 1)
+                ++n;
+            return n;
+#endif
+        }
+
+        /**
+         * Count the set bits of a word.
+         * @param word the word
+         * @return the number of set bits
+         */
+        static inline unsigned int popCount(const std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned int>(__builtin_popcountll(word));
+#else
+            unsigned int n = 0;
+            for (auto w = word; w; w &= w - 1)
+                ++n;
+            return n;
+#endif
+        }
+
+        /// The number of words needed to hold the given number of bits.
+        static constexpr std::size_t numWords(const std::size_t bits) noexcept {
+            return (bits + WordBits - 1) / WordBits;
+        }
+    };
+}
@@ -4,14 +4,24 @@
  * By Sebastian Raaphorst, 2018.
  */
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <random>
 
 #include "DefaultRNG.h"
+#include "URBGUtils.h"
 
 namespace spelunker::math {
     DefaultRNG::DefaultRNG()
         : rd(), g(rd()) {}
 
+    DefaultRNG::DefaultRNG(const std::uint64_t seed)
+        : rd() {
+        std::seed_seq seq{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+        g.seed(seq);
+    }
+
     int DefaultRNG::randomRangeImpl(int lower, int upper) noexcept {
         std::uniform_int_distribution<> dist(lower, upper-1);
         return dist(g);
@@ -21,4 +31,24 @@ namespace spelunker::math {
         std::uniform_real_distribution<double> unif(0, 1);
         return unif(g);
     }
-}
\ No newline at end of file
+
+    void DefaultRNG::randomRangesImpl(int lower, int upper, int *out, std::size_t n) noexcept {
+        // Draw the offsets from lower in bulk, a chunk at a time. The span is at most 2^32 - 1.
+        const auto span = static_cast<std::uint64_t>(static_cast<std::int64_t>(upper) - lower);
+        std::uint32_t draws[Chunk];
+        for (std::size_t i = 0; i < n; i += Chunk) {
+            const auto count = std::min(Chunk, n - i);
+            URBGUtils::fillBelow(g, span, draws, count);
+            for (std::size_t j = 0; j < count; ++j)
+                out[i + j] = static_cast<int>(static_cast<std::int64_t>(lower) + draws[j]);
+        }
+    }
+
+    void DefaultRNG::randomProbabilitiesImpl(double *out, std::size_t n) noexcept {
+        URBGUtils::fillProbabilities(g, out, n);
+    }
+
+    void DefaultRNG::randomWordsImpl(std::uint32_t *out, std::size_t n) noexcept {
+        URBGUtils::fillWords(g, out, n);
+    }
+}
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <random>
 
 #include "RNG.h"
@@ -22,6 +24,9 @@ namespace spelunker::math {
     class DefaultRNG final : public RNG {
     public:
         DefaultRNG();
+
+        /// Create a generator with an explicit seed, so that its draws may be reproduced.
+        explicit DefaultRNG(std::uint64_t seed);
         ~DefaultRNG() final = default;
 
     protected:
@@ -29,7 +34,16 @@ namespace spelunker::math {
 
         double randomProbabilityImpl() noexcept final;
 
+        void randomRangesImpl(int lower, int upper, int *out, std::size_t n) noexcept final;
+
+        void randomProbabilitiesImpl(double *out, std::size_t n) noexcept final;
+
+        void randomWordsImpl(std::uint32_t *out, std::size_t n) noexcept final;
+
     private:
+        /// The number of entries drawn at a time by randomRangesImpl.
+        static constexpr std::size_t Chunk = 256;
+
         std::random_device rd;
         std::mt19937 g;
     };
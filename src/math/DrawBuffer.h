@@ -0,0 +1,98 @@
+/**
+ * DrawBuffer.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Random draws served from words drawn in blocks.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+
+#include "URBGUtils.h"
+
+namespace spelunker::math {
+    /// A buffer of random words drawn from an engine in blocks, from which single draws are served.
+    /**
+     * Generators that make one small draw per step, with a bound that changes from step to step (e.g. the degree of
+     * the current vertex in a random walk), cannot draw their numbers in bulk up front, but they can draw the random
+     * words in bulk: the buffer refills itself with URBGUtils::fillWords, and each draw maps a word to its range
+     * with Lemire's multiply-shift, with no division.
+     *
+     * Over an RNGEngine, the buffer is refilled by a single virtual call to the RNG (see RNG::randomWordsImpl), so
+     * the draws do not match those made one at a time through RNG. The buffer holds a reference to the engine, which
+     * must outlive it. Words left in the buffer when it is destroyed are discarded.
+     * @tparam URBG the engine type
+     */
+    template<typename URBG>
+    class DrawBuffer final {
+    public:
+        /// The number of words drawn at a time.
+        static constexpr std::size_t Capacity = 256;
+
+        explicit DrawBuffer(URBG &g) noexcept : g{g} {}
+
+        DrawBuffer(const DrawBuffer&) = delete;
+        DrawBuffer &operator=(const DrawBuffer&) = delete;
+        ~DrawBuffer() = default;
+
+        /**
+         * Generate a number in the range [0,bound).
+         * @param bound the bound
+         * @return a number r such that 0 <= r < bound
+         * @throws invalid_argument if bound is 0
+         */
+        std::size_t below(std::size_t bound);
+
+        /// Generate a random number in the range [0,1).
+        double probability();
+
+        /// Select a random element from a nonempty collection.
+        template<typename Container>
+        inline auto &element(const Container &c) {
+            auto iter = std::begin(c);
+            std::advance(iter, below(static_cast<std::size_t>(std::distance(iter, std::end(c)))));
+            return *iter;
+        }
+
+    private:
+        URBG &g;
+        std::uint32_t words[Capacity];
+        std::size_t pos = Capacity;
+
+        inline std::uint32_t word() {
+            if (pos == Capacity) {
+                URBGUtils::fillWords(g, words, Capacity);
+                pos = 0;
+            }
+            return words[pos++];
+        }
+    };
+
+    template<typename URBG>
+    std::size_t DrawBuffer<URBG>::below(const std::size_t bound) {
+        if (bound == 0)
+            throw std::invalid_argument("DrawBuffer::below called with a bound of 0");
+        if (bound > UINT32_MAX)
+            return URBGUtils::randomRange(g, bound);
+
+        const auto b32 = static_cast<std::uint32_t>(bound);
+        auto m = static_cast<std::uint64_t>(word()) * b32;
+        if (static_cast<std::uint32_t>(m) < b32) {
+            const auto threshold = static_cast<std::uint32_t>(-b32) % b32;
+            while (static_cast<std::uint32_t>(m) < threshold)
+                m = static_cast<std::uint64_t>(word()) * b32;
+        }
+        return static_cast<std::size_t>(m >> 32);
+    }
+
+    template<typename URBG>
+    double DrawBuffer<URBG>::probability() {
+        const auto hi = word();
+        return URBGUtils::wordsToProbability(hi, word());
+    }
+}
@@ -0,0 +1,82 @@
+/**
+ * PhiloxEngine.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "PhiloxEngine.h"
+
+namespace spelunker::math {
+    PhiloxEngine::PhiloxEngine(const std::uint64_t seed, const std::uint64_t stream) noexcept
+        : seed{seed}, stream{stream} {}
+
+    void PhiloxEngine::fill(std::uint32_t *out, std::size_t n) noexcept {
+        // Finish the current block, if we are partway through it.
+        for (; n > 0 && (position & 3) != 0; --n)
+            *out++ = (*this)();
+
+        // Compute whole blocks, Lanes at a time, as structures of arrays so that each round is a vector operation
+        // across the lanes.
+        const std::uint32_t s0 = static_cast<std::uint32_t>(stream);
+        const std::uint32_t s1 = static_cast<std::uint32_t>(stream >> 32);
+        while (n >= 4) {
+            const auto lanes = std::min(Lanes, n / 4);
+            const auto first = position >> 2;
+
+            std::uint32_t c0[Lanes], c1[Lanes], c2[Lanes], c3[Lanes];
+            for (std::size_t j = 0; j < lanes; ++j) {
+                const auto b = first + j;
+                c0[j] = static_cast<std::uint32_t>(b);
+                c1[j] = static_cast<std::uint32_t>(b >> 32);
+                c2[j] = s0;
+                c3[j] = s1;
+            }
+
+            std::uint32_t k0 = static_cast<std::uint32_t>(seed);
+            std::uint32_t k1 = static_cast<std::uint32_t>(seed >> 32);
+            for (auto round = 0; round < 10; ++round) {
+                if (round > 0) {
+                    k0 += 0x9E3779B9;
+                    k1 += 0xBB67AE85;
+                }
+                for (std::size_t j = 0; j < lanes; ++j) {
+                    const auto p0 = std::uint64_t{0xD2511F53} * c0[j];
+                    const auto p1 = std::uint64_t{0xCD9E8D57} * c2[j];
+                    c0[j] = static_cast<std::uint32_t>(p1 >> 32) ^ c1[j] ^ k0;
+                    c1[j] = static_cast<std::uint32_t>(p1);
+                    c2[j] = static_cast<std::uint32_t>(p0 >> 32) ^ c3[j] ^ k1;
+                    c3[j] = static_cast<std::uint32_t>(p0);
+                }
+            }
+
+            for (std::size_t j = 0; j < lanes; ++j) {
+                *out++ = c0[j];
+                *out++ = c1[j];
+                *out++ = c2[j];
+                *out++ = c3[j];
+            }
+            position += 4 * lanes;
+            n -= 4 * lanes;
+        }
+
+        // Start the last, partial block.
+        for (; n > 0; --n)
+            *out++ = (*this)();
+    }
+
+    PhiloxEngine PhiloxEngine::split(const std::uint64_t s) const noexcept {
+        return PhiloxEngine{seed, s};
+    }
+
+    bool PhiloxEngine::operator==(const PhiloxEngine &other) const noexcept {
+        return seed == other.seed && stream == other.stream && position == other.position;
+    }
+
+    bool PhiloxEngine::operator!=(const PhiloxEngine &other) const noexcept {
+        return !(*this == other);
+    }
+}
@@ -0,0 +1,164 @@
+/**
+ * PhiloxEngine.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A counter-based random engine, for reproducible parallel generation.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace spelunker::math {
+    /// The Philox4x32-10 counter-based random engine.
+    /**
+     * Philox (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", 2011) computes its output as a keyed
+     * bijection of a counter, rather than by stepping a state. Here, the key is the 64-bit seed, and the counter is
+     * the pair (stream id, block index), each block yielding four 32-bit outputs. Thus:
+     * 1. Every stream of a seed is an independent sequence, so tiles, rows, or batch items may each be given their
+     *    own stream by id, with no coordination between threads.
+     * 2. Any position in a stream may be reached in constant time.
+     * It follows that what is drawn depends only on (seed, stream, position), and never on the number of threads or
+     * the order in which they run.
+     *
+     * For the same reason, ranged draws are made by randomBelow and randomProbability, which are defined here in
+     * terms of the 32-bit outputs alone, and not by the standard distributions, whose algorithms vary between
+     * standard libraries: URBGUtils uses them for this engine.
+     */
+    class PhiloxEngine final {
+    public:
+        using result_type = std::uint32_t;
+
+        /**
+         * Create an engine positioned at the start of a stream.
+         * @param seed the seed, which is the key of the bijection
+         * @param stream the id of the stream
+         */
+        explicit PhiloxEngine(std::uint64_t seed = 0, std::uint64_t stream = 0) noexcept;
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return UINT32_MAX; }
+
+        inline result_type operator()() noexcept {
+            const auto b = position >> 2;
+            if (!buffered || b != bufferedBlock) {
+                buffer = block(b);
+                bufferedBlock = b;
+                buffered = true;
+            }
+            return buffer[position++ & 3];
+        }
+
+        /**
+         * Generate a number in the range [0,bound) without bias.
+         * This uses Lemire's multiply-and-reject method, which is almost always a single output.
+         * @param bound the bound, which must be positive
+         * @return a number r such that 0 <= r < bound
+         */
+        inline std::uint64_t randomBelow(const std::uint64_t bound) noexcept {
+            if (bound <= UINT32_MAX) {
+                const auto b32 = static_cast<std::uint32_t>(bound);
+                auto m = static_cast<std::uint64_t>((*this)()) * b32;
+                if (static_cast<std::uint32_t>(m) < b32) {
+                    const auto threshold = static_cast<std::uint32_t>(-b32) % b32;
+                    while (static_cast<std::uint32_t>(m) < threshold)
+                        m = static_cast<std::uint64_t>((*this)()) * b32;
+                }
+                return m >> 32;
+            }
+
+            const auto threshold = (0 - bound) % bound;
+            auto x = next64();
+            while (x < threshold)
+                x = next64();
+            return x % bound;
+        }
+
+        /**
+         * Fill a buffer with the next n outputs, exactly as n calls to operator() would.
+         * Whole blocks are computed several at a time, with the lanes laid out so that the rounds vectorise.
+         * @param out the buffer
+         * @param n the number of outputs
+         */
+        void fill(std::uint32_t *out, std::size_t n) noexcept;
+
+        /// Generate a random number in the range [0,1) with 53 random bits.
+        inline double randomProbability() noexcept {
+            return static_cast<double>(next64() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        /// An engine for another stream of the same seed, positioned at its start.
+        PhiloxEngine split(std::uint64_t stream) const noexcept;
+
+        /// Skip ahead by n outputs in constant time.
+        inline void discard(const std::uint64_t n) noexcept { position += n; }
+
+        /// Move to the nth output of the stream in constant time.
+        inline void seek(const std::uint64_t n) noexcept { position = n; }
+
+        inline std::uint64_t getSeed() const noexcept { return seed; }
+        inline std::uint64_t getStream() const noexcept { return stream; }
+
+        /// The number of outputs drawn from the stream so far.
+        inline std::uint64_t getPosition() const noexcept { return position; }
+
+        /**
+         * The Philox4x32-10 bijection: the four outputs for the given counter and key.
+         * @param counter the counter
+         * @param key the key
+         * @return the outputs
+         */
+        static std::array<std::uint32_t, 4> philox(std::array<std::uint32_t, 4> counter,
+                                                   std::array<std::uint32_t, 2> key) noexcept;
+
+        bool operator==(const PhiloxEngine &other) const noexcept;
+        bool operator!=(const PhiloxEngine &other) const noexcept;
+
+    private:
+        /// The number of blocks computed at a time by fill.
+        static constexpr std::size_t Lanes = 16;
+
+        std::uint64_t seed;
+        std::uint64_t stream;
+        std::uint64_t position = 0;
+
+        std::array<std::uint32_t, 4> buffer{};
+        std::uint64_t bufferedBlock = 0;
+        bool buffered = false;
+
+        inline std::uint64_t next64() noexcept {
+            const std::uint64_t hi = (*this)();
+            return (hi << 32) | (*this)();
+        }
+
+        /// The outputs of the block at the given index of this stream.
+        inline std::array<std::uint32_t, 4> block(const std::uint64_t b) const noexcept {
+            return philox({static_cast<std::uint32_t>(b), static_cast<std::uint32_t>(b >> 32),
+                           static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)},
+                          {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)});
+        }
+    };
+
+    inline std::array<std::uint32_t, 4> PhiloxEngine::philox(std::array<std::uint32_t, 4> c,
+                                                             std::array<std::uint32_t, 2> k) noexcept {
+        constexpr std::uint64_t M0 = 0xD2511F53;
+        constexpr std::uint64_t M1 = 0xCD9E8D57;
+        constexpr std::uint32_t W0 = 0x9E3779B9;
+        constexpr std::uint32_t W1 = 0xBB67AE85;
+
+        for (auto round = 0; round < 10; ++round) {
+            if (round > 0) {
+                k[0] += W0;
+                k[1] += W1;
+            }
+            const auto p0 = M0 * c[0];
+            const auto p1 = M1 * c[2];
+            c = {static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<std::uint32_t>(p1),
+                 static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<std::uint32_t>(p0)};
+        }
+        return c;
+    }
+}
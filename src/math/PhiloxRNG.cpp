@@ -0,0 +1,42 @@
+/**
+ * PhiloxRNG.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "PhiloxEngine.h"
+#include "PhiloxRNG.h"
+#include "URBGUtils.h"
+
+namespace spelunker::math {
+    PhiloxRNG::PhiloxRNG(const std::uint64_t seed, const std::uint64_t stream) noexcept
+        : engine{seed, stream} {}
+
+    int PhiloxRNG::randomRangeImpl(const int lower, const int upper) noexcept {
+        const auto span = static_cast<std::uint64_t>(static_cast<std::int64_t>(upper) - lower);
+        return static_cast<int>(lower + static_cast<std::int64_t>(engine.randomBelow(span)));
+    }
+
+    double PhiloxRNG::randomProbabilityImpl() noexcept {
+        return engine.randomProbability();
+    }
+
+    void PhiloxRNG::randomRangesImpl(const int lower, const int upper, int *out, const std::size_t n) noexcept {
+        const auto span = static_cast<std::uint64_t>(static_cast<std::int64_t>(upper) - lower);
+        std::uint32_t draws[256];
+        for (std::size_t i = 0; i < n; i += 256) {
+            const auto count = std::min<std::size_t>(256, n - i);
+            URBGUtils::fillBelow(engine, span, draws, count);
+            for (std::size_t j = 0; j < count; ++j)
+                out[i + j] = static_cast<int>(lower + static_cast<std::int64_t>(draws[j]));
+        }
+    }
+
+    void PhiloxRNG::randomProbabilitiesImpl(double *out, const std::size_t n) noexcept {
+        URBGUtils::fillProbabilities(engine, out, n);
+    }
+}
@@ -0,0 +1,48 @@
+/**
+ * PhiloxRNG.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A random number generator over the counter-based Philox engine.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "PhiloxEngine.h"
+#include "RNG.h"
+
+namespace spelunker::math {
+    /// An RNG over a PhiloxEngine, which may be installed with RNG::setRNG.
+    /**
+     * The draws depend only on the seed, the stream, and the number of draws made, and are the same on every
+     * platform. The engine is exposed so that it may be split into further streams or moved to any position.
+     */
+    class PhiloxRNG final : public RNG {
+    public:
+        /**
+         * Create an RNG at the start of a stream.
+         * @param seed the seed
+         * @param stream the id of the stream
+         */
+        explicit PhiloxRNG(std::uint64_t seed, std::uint64_t stream = 0) noexcept;
+        ~PhiloxRNG() final = default;
+
+        inline PhiloxEngine &getEngine() noexcept { return engine; }
+        inline const PhiloxEngine &getEngine() const noexcept { return engine; }
+
+    protected:
+        int randomRangeImpl(int lower, int upper) noexcept final;
+
+        double randomProbabilityImpl() noexcept final;
+
+        void randomRangesImpl(int lower, int upper, int *out, std::size_t n) noexcept final;
+
+        void randomProbabilitiesImpl(double *out, std::size_t n) noexcept final;
+
+    private:
+        PhiloxEngine engine;
+    };
+}
@@ -5,6 +5,9 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <stdexcept>
@@ -16,20 +19,21 @@
 namespace spelunker::math {
     std::shared_ptr<RNG> RNG::rng = nullptr;
 
-    RNG::~RNG() {
-        rng.reset();
-    }
+    RNG::~RNG() = default;
 
     void RNG::setRNG(std::shared_ptr<RNG> &nRNG) noexcept {
-        if (rng) rng.reset();
-        rng = nRNG;
+        std::atomic_store(&rng, nRNG);
     }
 
     std::shared_ptr<RNG> RNG::getRNG() noexcept {
-        if (!rng) {
-            rng = std::make_shared<DefaultRNG>();
+        auto current = std::atomic_load(&rng);
+        if (!current) {
+            // If another thread installs an RNG first, use that one instead.
+            auto created = std::static_pointer_cast<RNG>(std::make_shared<DefaultRNG>());
+            if (std::atomic_compare_exchange_strong(&rng, &current, created))
+                current = created;
         }
-        return rng;
+        return current;
     }
 
     int RNG::randomRange(const int lower, const int upper) {
@@ -46,4 +50,36 @@ namespace spelunker::math {
     double RNG::randomProbability() {
         return getRNG()->randomProbabilityImpl();
     }
+
+    void RNG::randomRanges(const int lower, const int upper, int *out, const std::size_t n) {
+        if (lower >= upper) {
+            const std::string s = std::string("randomRanges called with invalid arguments: ") +
+                                  "lower = " + std::to_string(lower) +
+                                  " upper = " + std::to_string(upper);
+            throw std::invalid_argument(s);
+        }
+
+        getRNG()->randomRangesImpl(lower, upper, out, n);
+    }
+
+    void RNG::randomProbabilities(double *out, const std::size_t n) {
+        getRNG()->randomProbabilitiesImpl(out, n);
+    }
+
+    void RNG::randomRangesImpl(const int lower, const int upper, int *out, const std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = randomRangeImpl(lower, upper);
+    }
+
+    void RNG::randomProbabilitiesImpl(double *out, const std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = randomProbabilityImpl();
+    }
+
+    void RNG::randomWordsImpl(std::uint32_t *out, const std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto hi = static_cast<std::uint32_t>(randomRangeImpl(0, 1 << 16));
+            out[i] = (hi << 16) | static_cast<std::uint32_t>(randomRangeImpl(0, 1 << 16));
+        }
+    }
 }
\ No newline at end of file
@@ -7,16 +7,26 @@
  */
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 
 #pragma once
 
 namespace spelunker::math {
+    class RNGEngine;
+
     /**
      * The abstract superclass for random number generation algorithms.
      * Implementations can be provided and set. If no implementation is provided,
      * the instance defaults to @see{DefaultRNG}.
+     *
+     * Installing and fetching the RNG is thread-safe, but the RNG itself is shared by the whole process and its
+     * draws are not synchronised: to generate from several threads, or reproducibly, give each generation its own
+     * engine instead, e.g. the SeededEngine of a GenerationContext.
      */
     class RNG {
     public:
@@ -52,6 +62,24 @@ namespace spelunker::math {
          */
         static double randomProbability();
 
+        /**
+         * Fill a buffer with numbers in the range [lower,upper).
+         * This looks up the RNG and checks the range once, and makes one virtual call, for the whole buffer.
+         * @param lower the lower bound on the range (inclusive)
+         * @param upper the upper bound on the range (exclusive)
+         * @param out the buffer
+         * @param n the number of entries to fill
+         * @throws invalid_argument if lower >= upper
+         */
+        static void randomRanges(int lower, int upper, int *out, std::size_t n);
+
+        /**
+         * Fill a buffer with random numbers in the range [0,1).
+         * @param out the buffer
+         * @param n the number of entries to fill
+         */
+        static void randomProbabilities(double *out, std::size_t n);
+
         /// Select a random element from a collection.
         /**
          * Given an STL collection, returns a reference to a random element in it.
@@ -86,7 +114,29 @@ namespace spelunker::math {
          */
         virtual double randomProbabilityImpl() noexcept = 0;
 
+        /**
+         * Fill a buffer with numbers in the range [lower,upper), where RNG has already checked that lower < upper.
+         * By default, this calls randomRangeImpl for each entry: subclasses may override it to draw in bulk.
+         */
+        virtual void randomRangesImpl(int lower, int upper, int *out, std::size_t n) noexcept;
+
+        /**
+         * Fill a buffer with random numbers in the range [0,1).
+         * By default, this calls randomProbabilityImpl for each entry: subclasses may override it to draw in bulk.
+         */
+        virtual void randomProbabilitiesImpl(double *out, std::size_t n) noexcept;
+
+        /**
+         * Fill a buffer with uniform 32-bit words, e.g. for the buffered draws of an RNGEngine.
+         * By default, this makes each word from two 16-bit draws of randomRangeImpl: subclasses may override it to
+         * draw in bulk.
+         */
+        virtual void randomWordsImpl(std::uint32_t *out, std::size_t n) noexcept;
+
     private:
+        /// The engine adapter draws from the implementation directly.
+        friend class RNGEngine;
+
         /// The random number generator. RNG takes access to it.
         static std::shared_ptr<RNG> rng;
     };
@@ -94,24 +144,32 @@ namespace spelunker::math {
 
     template<typename Container>
     auto &RNG::randomElement(const Container &c) {
-        auto iter       = c.begin();
-        const auto size = std::distance(iter, c.end());
-        auto r          = getRNG();
-        const auto idx  = r->randomRange(static_cast<int>(size));
-
-        std::advance(iter, idx);
-        return *iter;
+        const auto size = static_cast<int>(std::size(c));
+        if (size <= 0)
+            throw std::invalid_argument("randomElement called on an empty collection");
+
+        // Look up the RNG once, and draw from it directly, as the range is known to be valid.
+        const auto idx = getRNG()->randomRangeImpl(0, size);
+        if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                typename std::iterator_traits<decltype(std::begin(c))>::iterator_category>) {
+            return std::begin(c)[idx];
+        } else {
+            auto iter = std::begin(c);
+            std::advance(iter, idx);
+            return *iter;
+        }
     }
 
     template<typename Container>
     void RNG::shuffle(Container &c) {
-        auto r = getRNG();
+        // Look up the RNG once, and draw from it directly, as each range [i, size) is known to be valid.
+        const auto r = getRNG();
 
         // c.size is unsigned, so we must cast to int for the case that it is 0.
-        const auto maxPos = static_cast<int>(c.size()) - 1;
-        for (auto i=0; i < maxPos; ++i) {
+        const auto size = static_cast<int>(c.size());
+        for (auto i=0; i < size - 1; ++i) {
             // Find a random element and swap it with begin.
-            const auto idx = randomRange(i, c.size());
+            const auto idx = r->randomRangeImpl(i, size);
             std::swap(c[i], c[idx]);
         }
     }
@@ -0,0 +1,82 @@
+/**
+ * RNGEngine.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "RNG.h"
+#include "RNGEngine.h"
+
+namespace spelunker::math {
+    RNGEngine::RNGEngine()
+        : rng{RNG::getRNG()} {}
+
+    RNGEngine::RNGEngine(std::shared_ptr<RNG> rng) noexcept
+        : rng{std::move(rng)} {}
+
+    RNGEngine::result_type RNGEngine::operator()() noexcept {
+        return static_cast<result_type>(rng->randomRangeImpl(0, std::numeric_limits<int>::max()));
+    }
+
+    int RNGEngine::randomRange(const int lower, const int upper) {
+        if (lower >= upper) {
+            const std::string s = std::string("randomRange called with invalid arguments: ") +
+                                  "lower = " + std::to_string(lower) +
+                                  " upper = " + std::to_string(upper);
+            throw std::invalid_argument(s);
+        }
+
+        return rng->randomRangeImpl(lower, upper);
+    }
+
+    std::uint64_t RNGEngine::randomBelow(const std::uint64_t bound) {
+        if (bound == 0)
+            throw std::invalid_argument("randomBelow called with a bound of 0");
+        if (bound <= static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+            return static_cast<std::uint64_t>(rng->randomRangeImpl(0, static_cast<int>(bound)));
+
+        // Assemble 64 bits from draws of 30 bits each, rejecting the words that would bias the remainder.
+        const auto word = [this] {
+            std::uint64_t x = 0;
+            for (int i = 0; i < 3; ++i)
+                x = (x << 30) | static_cast<std::uint64_t>(rng->randomRangeImpl(0, 1 << 30));
+            return x;
+        };
+        const auto threshold = (0 - bound) % bound;
+        auto x = word();
+        while (x < threshold)
+            x = word();
+        return x % bound;
+    }
+
+    double RNGEngine::randomProbability() noexcept {
+        return rng->randomProbabilityImpl();
+    }
+
+    void RNGEngine::randomRanges(const int lower, const int upper, int *out, const std::size_t n) {
+        if (lower >= upper) {
+            const std::string s = std::string("randomRanges called with invalid arguments: ") +
+                                  "lower = " + std::to_string(lower) +
+                                  " upper = " + std::to_string(upper);
+            throw std::invalid_argument(s);
+        }
+
+        rng->randomRangesImpl(lower, upper, out, n);
+    }
+
+    void RNGEngine::randomProbabilities(double *out, const std::size_t n) noexcept {
+        rng->randomProbabilitiesImpl(out, n);
+    }
+
+    void RNGEngine::fill(std::uint32_t *out, const std::size_t n) noexcept {
+        rng->randomWordsImpl(out, n);
+    }
+}
@@ -0,0 +1,78 @@
+/**
+ * RNGEngine.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * A uniform random bit generator that draws from the current RNG.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include "RNG.h"
+
+namespace spelunker::math {
+    /// A type-erased engine over the current RNG.
+    /**
+     * Algorithms templated on a random engine take this engine to draw from the RNG set by RNG::setRNG, e.g. to
+     * plug in a custom RNG subclass. The RNG is looked up once, at construction, rather than once per draw.
+     *
+     * It is a standard uniform random bit generator, but URBGUtils forwards ranged draws on it straight to the RNG,
+     * so that an algorithm draws exactly the same numbers through this engine as it would through the static
+     * members of RNG. Buffered draws (see DrawBuffer) are the exception: they refill with fill, a single virtual call
+     * per buffer, and so differ from those made one at a time.
+     */
+    class RNGEngine final {
+    public:
+        using result_type = unsigned int;
+
+        /// Capture the current RNG.
+        RNGEngine();
+
+        /// Capture a specific RNG.
+        explicit RNGEngine(std::shared_ptr<RNG> rng) noexcept;
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<int>::max() - 1; }
+
+        /// A random number in the range [min(), max()].
+        result_type operator()() noexcept;
+
+        /**
+         * Generate a number in the range [lower,upper).
+         * @param lower the lower bound on the range (inclusive)
+         * @param upper the upper bound on the range (exclusive)
+         * @return a number r such that lower <= r < upper
+         * @throws invalid_argument if lower >= upper
+         */
+        int randomRange(int lower, int upper);
+
+        /**
+         * Generate a number in the range [0,bound), for bounds too large for randomRange. Bounds that fit in an int
+         * are forwarded to randomRange, and larger ones are drawn from 64 random bits assembled from several draws.
+         * @param bound the bound
+         * @return a number r such that 0 <= r < bound
+         * @throws invalid_argument if bound is 0
+         */
+        std::uint64_t randomBelow(std::uint64_t bound);
+
+        /// Generate a random number in the range [0,1).
+        double randomProbability() noexcept;
+
+        /// Fill a buffer with numbers in the range [lower,upper): see RNG::randomRanges.
+        void randomRanges(int lower, int upper, int *out, std::size_t n);
+
+        /// Fill a buffer with random numbers in the range [0,1).
+        void randomProbabilities(double *out, std::size_t n) noexcept;
+
+        /// Fill a buffer with uniform 32-bit words, with a single virtual call: URBGUtils::fillWords uses this.
+        void fill(std::uint32_t *out, std::size_t n) noexcept;
+
+    private:
+        std::shared_ptr<RNG> rng;
+    };
+}
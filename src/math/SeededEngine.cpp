@@ -0,0 +1,63 @@
+/**
+ * SeededEngine.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "SeededEngine.h"
+
+namespace spelunker::math {
+    SeededEngine::SeededEngine(const std::uint64_t seed) noexcept
+        : seed{seed}, engine{seed} {}
+
+    SeededEngine::SeededEngine()
+        : SeededEngine{randomSeed()} {}
+
+    void SeededEngine::reseed(const std::uint64_t s) noexcept {
+        seed = s;
+        engine.seed(s);
+    }
+
+    std::string SeededEngine::getState() const {
+        std::ostringstream out;
+        out << *this;
+        return out.str();
+    }
+
+    void SeededEngine::setState(const std::string &state) {
+        std::istringstream in{state};
+        SeededEngine e{0};
+        if (!(in >> e))
+            throw std::invalid_argument("SeededEngine::setState called with an invalid state");
+        *this = e;
+    }
+
+    std::uint64_t SeededEngine::randomSeed() {
+        std::random_device rd;
+        return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+    }
+
+    bool SeededEngine::operator==(const SeededEngine &other) const noexcept {
+        return seed == other.seed && engine == other.engine;
+    }
+
+    bool SeededEngine::operator!=(const SeededEngine &other) const noexcept {
+        return !(*this == other);
+    }
+
+    std::ostream &operator<<(std::ostream &out, const SeededEngine &e) {
+        return out << e.seed << ' ' << e.engine;
+    }
+
+    std::istream &operator>>(std::istream &in, SeededEngine &e) {
+        return in >> e.seed >> e.engine;
+    }
+}
@@ -0,0 +1,72 @@
+/**
+ * SeededEngine.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * An explicitly seeded random engine, to be owned by whatever uses it.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <random>
+#include <string>
+
+namespace spelunker::math {
+    /// An explicitly seeded, reproducible random engine.
+    /**
+     * This is a uniform random bit generator over a 64-bit Mersenne twister. Unlike the global RNG, it is meant to be
+     * owned: give each thread its own (e.g. through a GenerationContext) and there is no shared mutable state.
+     *
+     * The engine remembers the 64-bit seed from which it was last seeded, so that anything generated from it can be
+     * replayed by reseeding. Its full state can also be saved and restored, to resume mid-stream.
+     */
+    class SeededEngine final {
+    public:
+        using result_type = std::uint64_t;
+
+        /// Create an engine seeded from the given seed.
+        explicit SeededEngine(std::uint64_t seed) noexcept;
+
+        /// Create an engine with a seed drawn from std::random_device, which may be retrieved with getSeed.
+        SeededEngine();
+
+        static constexpr result_type min() noexcept { return std::mt19937_64::min(); }
+        static constexpr result_type max() noexcept { return std::mt19937_64::max(); }
+
+        inline result_type operator()() noexcept { return engine(); }
+
+        /// Restart the engine from the given seed.
+        void reseed(std::uint64_t seed) noexcept;
+
+        /// The seed from which the engine was last seeded.
+        inline std::uint64_t getSeed() const noexcept { return seed; }
+
+        /**
+         * Serialise the state of the engine: the seed, followed by the state of the Mersenne twister.
+         * @return the state as text
+         */
+        std::string getState() const;
+
+        /**
+         * Restore the state of the engine from the output of getState.
+         * @param state the state as text
+         * @throws invalid_argument if the state cannot be parsed
+         */
+        void setState(const std::string &state);
+
+        /// Draw a seed from std::random_device.
+        static std::uint64_t randomSeed();
+
+        bool operator==(const SeededEngine &other) const noexcept;
+        bool operator!=(const SeededEngine &other) const noexcept;
+
+        friend std::ostream &operator<<(std::ostream &out, const SeededEngine &e);
+        friend std::istream &operator>>(std::istream &in, SeededEngine &e);
+
+    private:
+        std::uint64_t seed;
+        std::mt19937_64 engine;
+    };
+}
@@ -0,0 +1,33 @@
+/**
+ * SmallRandom.cpp
+ *
+ * By Sebastian Raaphorst, 2018.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SmallRandom.h"
+
+namespace spelunker::math {
+    const std::vector<std::uint8_t> SmallRandom::permutationTable = [] {
+        std::vector<std::uint8_t> table;
+        for (std::size_t n = 1; n <= SmallRandom::MaxTableDegree; ++n) {
+            std::array<std::uint8_t, SmallRandom::MaxTableDegree> p{};
+            for (std::size_t i = 0; i < n; ++i)
+                p[i] = static_cast<std::uint8_t>(i);
+            do {
+                table.insert(table.end(), p.begin(), p.begin() + n);
+            } while (std::next_permutation(p.begin(), p.begin() + n));
+        }
+        return table;
+    }();
+
+    const std::uint8_t *SmallRandom::permutations(const std::size_t n) noexcept {
+        // Skip the tables for the smaller sizes k, each of which has k! rows of length k: these sum to n! - 1.
+        return permutationTable.data() + factorial(n) - 1;
+    }
+}
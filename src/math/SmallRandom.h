@@ -0,0 +1,163 @@
+/**
+ * SmallRandom.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Random choice and shuffling specialised for the small collections that arise as the neighbours of a vertex.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "RNGEngine.h"
+#include "URBGUtils.h"
+
+namespace spelunker::math {
+    /**
+     * A class with purely static members to choose from and shuffle random access collections of at most MaxDegree
+     * elements, which covers the neighbours of any vertex of the templates here, using a single random word:
+     * 1. To choose, the word is mapped to [0,n) by Lemire's multiply-shift.
+     * 2. To shuffle at most MaxTableDegree elements, the word is mapped to [0,n!) and used to index a table of the
+     *    permutations of [0,n).
+     * 3. To shuffle more, the word is split into the n-1 bounded draws of a Fisher-Yates shuffle by successive
+     *    multiply-shifts (Brackett-Rozinsky and Lemire's batched ranged draws), which is possible as 8! < 2^32.
+     * In all cases, a word that would bias the result is rejected and redrawn, which is rare.
+     *
+     * Larger collections fall back to URBGUtils. Over an RNGEngine, everything is forwarded to URBGUtils too, so that
+     * the draws match those made through RNG exactly.
+     */
+    class SmallRandom final {
+    private:
+        SmallRandom() = default;
+        ~SmallRandom() = default;
+
+    public:
+        /// The largest collection handled with a single word.
+        static constexpr std::size_t MaxDegree = 8;
+
+        /// The largest collection shuffled by permutation table.
+        static constexpr std::size_t MaxTableDegree = 5;
+
+        /**
+         * Generate a number in the range [0,n).
+         * @throws invalid_argument if n is 0
+         */
+        template<typename URBG>
+        static std::size_t choose(URBG &g, std::size_t n);
+
+        /// Select a random element from a nonempty random access collection.
+        template<typename URBG, typename Container>
+        static inline auto &element(URBG &g, const Container &c) {
+            if constexpr (isRNGEngine<URBG>)
+                return URBGUtils::randomElement(g, c);
+            else
+                return c[choose(g, std::size(c))];
+        }
+
+        /// Shuffle a random access collection.
+        template<typename URBG, typename Container>
+        static void shuffle(URBG &g, Container &c);
+
+        /**
+         * The permutations of [0,n) in lexicographic order, for n <= MaxTableDegree, as n! consecutive rows of n
+         * entries each.
+         * @param n the size of the permutations
+         * @return a pointer to the first row
+         */
+        static const std::uint8_t *permutations(std::size_t n) noexcept;
+
+    private:
+        template<typename URBG>
+        static constexpr bool isRNGEngine = std::is_same_v<URBG, RNGEngine>;
+
+        /// The permutations of [0,n) for every n <= MaxTableDegree, concatenated.
+        static const std::vector<std::uint8_t> permutationTable;
+
+        static constexpr std::uint32_t factorial(const std::size_t n) noexcept {
+            return n <= 1 ? 1 : static_cast<std::uint32_t>(n) * factorial(n - 1);
+        }
+
+        template<typename URBG>
+        static inline std::uint32_t word(URBG &g) {
+            std::uint32_t w;
+            URBGUtils::fillWords(g, &w, 1);
+            return w;
+        }
+
+        /// Map a random word to [0,bound) by multiply-shift with rejection.
+        template<typename URBG>
+        static inline std::uint32_t below(URBG &g, const std::uint32_t bound) {
+            auto m = static_cast<std::uint64_t>(word(g)) * bound;
+            if (static_cast<std::uint32_t>(m) < bound) {
+                const auto threshold = static_cast<std::uint32_t>(-bound) % bound;
+                while (static_cast<std::uint32_t>(m) < threshold)
+                    m = static_cast<std::uint64_t>(word(g)) * bound;
+            }
+            return static_cast<std::uint32_t>(m >> 32);
+        }
+    };
+
+    template<typename URBG>
+    std::size_t SmallRandom::choose(URBG &g, const std::size_t n) {
+        if constexpr (isRNGEngine<URBG>) {
+            return URBGUtils::randomRange(g, n);
+        } else {
+            if (n == 0)
+                throw std::invalid_argument("SmallRandom::choose called on an empty range");
+            if (n > UINT32_MAX)
+                return URBGUtils::randomRange(g, n);
+            return below(g, static_cast<std::uint32_t>(n));
+        }
+    }
+
+    template<typename URBG, typename Container>
+    void SmallRandom::shuffle(URBG &g, Container &c) {
+        const auto n = static_cast<std::size_t>(std::size(c));
+        if constexpr (isRNGEngine<URBG>) {
+            URBGUtils::shuffle(g, c);
+        } else {
+            if (n <= 1)
+                return;
+            if (n > MaxDegree) {
+                URBGUtils::shuffle(g, c);
+                return;
+            }
+
+            if (n <= MaxTableDegree) {
+                // Pick a permutation at random and apply it.
+                const auto row = permutations(n) + below(g, factorial(n)) * n;
+                std::remove_const_t<std::remove_reference_t<decltype(c[0])>> original[MaxTableDegree];
+                for (std::size_t i = 0; i < n; ++i)
+                    original[i] = std::move(c[i]);
+                for (std::size_t i = 0; i < n; ++i)
+                    c[i] = std::move(original[row[i]]);
+                return;
+            }
+
+            // Split one word into the draws for positions 0, ..., n-2, each bounded by the number of positions left,
+            // keeping the low half of each product as the word for the next draw. The draws are unbiased if the
+            // final low half is at least (2^32 - n!) mod n!.
+            const auto total = factorial(n);
+            std::size_t draws[MaxDegree];
+            while (true) {
+                std::uint32_t x = word(g);
+                for (std::size_t i = 0; i + 1 < n; ++i) {
+                    const auto m = static_cast<std::uint64_t>(x) * (n - i);
+                    draws[i] = i + static_cast<std::size_t>(m >> 32);
+                    x = static_cast<std::uint32_t>(m);
+                }
+                if (x >= total || x >= static_cast<std::uint32_t>(-total) % total)
+                    break;
+            }
+            for (std::size_t i = 0; i + 1 < n; ++i)
+                std::swap(c[i], c[draws[i]]);
+        }
+    }
+}
@@ -0,0 +1,277 @@
+/**
+ * URBGUtils.h
+ *
+ * By Sebastian Raaphorst, 2018.
+ *
+ * Random draws over a random engine supplied by the caller, as opposed to the global RNG.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "RNGEngine.h"
+
+namespace spelunker::math {
+    /**
+     * A class with purely static members offering the draws of RNG over any uniform random bit generator (URBG),
+     * e.g. a std::mt19937 or an RNGEngine.
+     *
+     * As the engine type is a template parameter, the draws are inlined into the calling algorithm: there is no
+     * lookup of the global RNG and no virtual call. There are two exceptions:
+     * 1. The draws on an RNGEngine are forwarded to its RNG, so that they match those made through RNG exactly.
+     *    Ranges too large for an int, which RNG cannot draw, are drawn by RNGEngine::randomBelow instead.
+     * 2. An engine that offers its own unbiased draws, as members randomBelow(std::uint64_t bound) and
+     *    randomProbability(), as a PhiloxEngine does, uses them instead of the standard distributions, whose
+     *    results vary between standard libraries.
+     */
+    class URBGUtils final {
+    private:
+        URBGUtils() = default;
+        ~URBGUtils() = default;
+
+    public:
+        /**
+         * Generate a number in the range [lower,upper).
+         * @tparam URBG the engine type
+         * @tparam Int the integral type of the bounds
+         * @param g the engine
+         * @param lower the lower bound on the range (inclusive)
+         * @param upper the upper bound on the range (exclusive)
+         * @return a number r such that lower <= r < upper
+         * @throws invalid_argument if lower >= upper
+         */
+        template<typename URBG, typename Int>
+        static Int randomRange(URBG &g, Int lower, Int upper);
+
+        /// Generate a number in the range [0,upper).
+        template<typename URBG, typename Int>
+        static inline Int randomRange(URBG &g, const Int upper) { return randomRange(g, Int{0}, upper); }
+
+        /// Generate a random number in the range [0,1).
+        template<typename URBG>
+        static double randomProbability(URBG &g);
+
+        /// Select a random element from a nonempty collection.
+        template<typename URBG, typename Container>
+        static auto &randomElement(URBG &g, const Container &c);
+
+        /// Shuffle a random access collection, drawing as RNG::shuffle does.
+        template<typename URBG, typename Container>
+        static void shuffle(URBG &g, Container &c);
+
+        /**
+         * Fill a buffer with uniform 32-bit words.
+         * An engine that offers a member fill(std::uint32_t*, std::size_t), as a PhiloxEngine does, fills the buffer
+         * in bulk, and an engine with 32 or 64 bits of output is used directly.
+         * @param g the engine
+         * @param out the buffer
+         * @param n the number of words
+         */
+        template<typename URBG>
+        static void fillWords(URBG &g, std::uint32_t *out, std::size_t n);
+
+        /**
+         * Fill a buffer with numbers in the range [0,bound).
+         * The words are drawn in bulk and mapped by Lemire's nearly divisionless multiply-shift, a multiplication
+         * per entry with no division, in loops that vectorise. A word that would bias the result is rejected and
+         * redrawn, which happens with probability less than bound / 2^32. An RNGEngine forwards to RNG::randomRanges.
+         * @param g the engine
+         * @param bound the bound, where 0 < bound <= 2^32 (or INT_MAX for an RNGEngine)
+         * @param out the buffer
+         * @param n the number of entries
+         * @throws invalid_argument if the bound is out of range
+         */
+        template<typename URBG>
+        static void fillBelow(URBG &g, std::uint64_t bound, std::uint32_t *out, std::size_t n);
+
+        /**
+         * Fill a buffer with random numbers in the range [0,1), each made from 53 bits of two words drawn in bulk.
+         * An RNGEngine forwards to RNG::randomProbabilities.
+         * @param g the engine
+         * @param out the buffer
+         * @param n the number of entries
+         */
+        template<typename URBG>
+        static void fillProbabilities(URBG &g, double *out, std::size_t n);
+
+        /// Make a random number in the range [0,1) from two uniform 32-bit words.
+        static inline double wordsToProbability(const std::uint32_t hi, const std::uint32_t lo) noexcept {
+            return static_cast<double>(((static_cast<std::uint64_t>(hi) << 32) | lo) >> 11)
+                   * (1.0 / 9007199254740992.0);
+        }
+
+    private:
+        template<typename URBG>
+        static constexpr bool isRNGEngine = std::is_same_v<URBG, RNGEngine>;
+
+        /// Determine if a value can be passed to RNG, which draws ints.
+        template<typename Int>
+        static constexpr bool fitsInt(const Int x) noexcept {
+            if constexpr (std::is_signed_v<Int>)
+                return x >= std::numeric_limits<int>::min() && x <= std::numeric_limits<int>::max();
+            else
+                return x <= static_cast<unsigned int>(std::numeric_limits<int>::max());
+        }
+
+        template<typename URBG, typename = void>
+        struct HasOwnDraws : std::false_type {};
+
+        template<typename URBG>
+        struct HasOwnDraws<URBG, std::void_t<
+                decltype(std::declval<URBG&>().randomBelow(std::uint64_t{1})),
+                decltype(std::declval<URBG&>().randomProbability())>> : std::true_type {};
+
+        template<typename URBG, typename = void>
+        struct HasFill : std::false_type {};
+
+        template<typename URBG>
+        struct HasFill<URBG, std::void_t<
+                decltype(std::declval<URBG&>().fill(std::declval<std::uint32_t*>(), std::size_t{0}))>>
+                : std::true_type {};
+
+        /// The number of entries converted at a time by the bulk draws that need scratch space.
+        static constexpr std::size_t Chunk = 256;
+    };
+
+    template<typename URBG, typename Int>
+    Int URBGUtils::randomRange(URBG &g, const Int lower, const Int upper) {
+        if constexpr (isRNGEngine<URBG>) {
+            // Ranges that fit in an int are forwarded to RNG, and larger ones are drawn in 64 bits.
+            if (fitsInt(lower) && fitsInt(upper))
+                return static_cast<Int>(g.randomRange(static_cast<int>(lower), static_cast<int>(upper)));
+            if (lower >= upper)
+                throw std::invalid_argument("randomRange called with an empty range");
+            const auto span = static_cast<std::uint64_t>(upper) - static_cast<std::uint64_t>(lower);
+            return static_cast<Int>(lower + static_cast<Int>(g.randomBelow(span)));
+        } else if constexpr (HasOwnDraws<URBG>::value) {
+            if (lower >= upper)
+                throw std::invalid_argument("randomRange called with an empty range");
+            const auto span = static_cast<std::uint64_t>(upper) - static_cast<std::uint64_t>(lower);
+            return static_cast<Int>(lower + static_cast<Int>(g.randomBelow(span)));
+        } else {
+            if (lower >= upper)
+                throw std::invalid_argument("randomRange called with an empty range");
+            std::uniform_int_distribution<Int> dist(lower, upper - 1);
+            return dist(g);
+        }
+    }
+
+    template<typename URBG>
+    double URBGUtils::randomProbability(URBG &g) {
+        if constexpr (isRNGEngine<URBG> || HasOwnDraws<URBG>::value) {
+            return g.randomProbability();
+        } else {
+            std::uniform_real_distribution<double> unif(0, 1);
+            return unif(g);
+        }
+    }
+
+    template<typename URBG, typename Container>
+    auto &URBGUtils::randomElement(URBG &g, const Container &c) {
+        auto iter       = std::begin(c);
+        const auto size = static_cast<std::size_t>(std::distance(iter, std::end(c)));
+        std::advance(iter, randomRange(g, size));
+        return *iter;
+    }
+
+    template<typename URBG, typename Container>
+    void URBGUtils::shuffle(URBG &g, Container &c) {
+        const auto size = static_cast<std::size_t>(std::size(c));
+        for (std::size_t i = 0; i + 1 < size; ++i) {
+            // Find a random element and swap it with position i.
+            const auto idx = randomRange(g, i, size);
+            std::swap(c[i], c[idx]);
+        }
+    }
+
+    template<typename URBG>
+    void URBGUtils::fillWords(URBG &g, std::uint32_t *out, const std::size_t n) {
+        if constexpr (HasFill<URBG>::value) {
+            g.fill(out, n);
+        } else if constexpr (URBG::min() == 0 && URBG::max() == UINT32_MAX) {
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = static_cast<std::uint32_t>(g());
+        } else if constexpr (URBG::min() == 0 && URBG::max() == UINT64_MAX) {
+            std::size_t i = 0;
+            for (; i + 1 < n; i += 2) {
+                const std::uint64_t x = g();
+                out[i] = static_cast<std::uint32_t>(x >> 32);
+                out[i + 1] = static_cast<std::uint32_t>(x);
+            }
+            if (i < n)
+                out[i] = static_cast<std::uint32_t>(g() >> 32);
+        } else {
+            std::uniform_int_distribution<std::uint32_t> dist;
+            for (std::size_t i = 0; i < n; ++i)
+                out[i] = dist(g);
+        }
+    }
+
+    template<typename URBG>
+    void URBGUtils::fillBelow(URBG &g, const std::uint64_t bound, std::uint32_t *out, const std::size_t n) {
+        if constexpr (isRNGEngine<URBG>) {
+            if (bound == 0 || bound > static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+                throw std::invalid_argument("fillBelow called with a bound outside of (0, INT_MAX]");
+            int draws[Chunk];
+            for (std::size_t i = 0; i < n; i += Chunk) {
+                const auto count = std::min(Chunk, n - i);
+                g.randomRanges(0, static_cast<int>(bound), draws, count);
+                for (std::size_t j = 0; j < count; ++j)
+                    out[i + j] = static_cast<std::uint32_t>(draws[j]);
+            }
+        } else {
+            if (bound == 0 || bound > (std::uint64_t{1} << 32))
+                throw std::invalid_argument("fillBelow called with a bound outside of (0, 2^32]");
+            fillWords(g, out, n);
+            if (bound == (std::uint64_t{1} << 32))
+                return;
+
+            // Count the words that must be rejected: almost always none, in which case we map them all at once.
+            const auto b32 = static_cast<std::uint32_t>(bound);
+            const auto threshold = static_cast<std::uint32_t>(-b32) % b32;
+            std::size_t rejected = 0;
+            for (std::size_t i = 0; i < n; ++i)
+                rejected += static_cast<std::uint32_t>(static_cast<std::uint64_t>(out[i]) * b32) < threshold;
+
+            if (rejected == 0) {
+                for (std::size_t i = 0; i < n; ++i)
+                    out[i] = static_cast<std::uint32_t>((static_cast<std::uint64_t>(out[i]) * b32) >> 32);
+                return;
+            }
+
+            for (std::size_t i = 0; i < n; ++i) {
+                auto m = static_cast<std::uint64_t>(out[i]) * b32;
+                while (static_cast<std::uint32_t>(m) < threshold) {
+                    std::uint32_t w;
+                    fillWords(g, &w, 1);
+                    m = static_cast<std::uint64_t>(w) * b32;
+                }
+                out[i] = static_cast<std::uint32_t>(m >> 32);
+            }
+        }
+    }
+
+    template<typename URBG>
+    void URBGUtils::fillProbabilities(URBG &g, double *out, const std::size_t n) {
+        if constexpr (isRNGEngine<URBG>) {
+            g.randomProbabilities(out, n);
+        } else {
+            std::uint32_t words[2 * Chunk];
+            for (std::size_t i = 0; i < n; i += Chunk) {
+                const auto count = std::min(Chunk, n - i);
+                fillWords(g, words, 2 * count);
+                for (std::size_t j = 0; j < count; ++j)
+                    out[i + j] = wordsToProbability(words[2 * j], words[2 * j + 1]);
+            }
+        }
+    }
+}
@@ -66,6 +66,9 @@ namespace spelunker::types {
     inline unsigned int dirIdx(const Direction &d) {
         return static_cast<unsigned int>(d);
     }
+
+    /// The number of directions, i.e. one more than the largest dirIdx.
+    constexpr unsigned int NumDirections = static_cast<unsigned int>(Direction::IN) + 1;
 }
 
 BOOST_CLASS_VERSION(spelunker::types::Direction, 1)